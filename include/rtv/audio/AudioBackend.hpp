@@ -0,0 +1,116 @@
+/**
+ * AudioBackend.hpp - Device I/O and clock underneath AudioEngine
+ *
+ * AudioEngine owns everything between the device and the application:
+ * capture hand-off, the render tap and echo canceller, beamforming, the
+ * capture broadcast, the playback mixer and telemetry. A backend only
+ * moves blocks and decides when they move - PortAudio streams on a sound
+ * card, WAV files and a clock thread on hosts without one.
+ */
+
+#pragma once
+
+#include "rtv/audio/AudioEngineTypes.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace rtv::audio {
+
+struct AudioConfig;
+
+/**
+ * Device-reported conditions for one block
+ */
+struct BlockStatus {
+    bool input_overflow = false;
+    bool input_underflow = false;
+    bool output_overflow = false;
+    bool output_underflow = false;
+};
+
+/**
+ * Granted stream latencies in seconds (0 when the backend has none)
+ */
+struct BackendLatency {
+    double input = 0.0;
+    double output = 0.0;
+};
+
+/**
+ * Engine side of a backend, called from the backend's I/O thread(s).
+ * Buffers are interleaved: input carries AudioConfig::capture_channels
+ * samples per frame, output AudioConfig::channels.
+ */
+class AudioIO {
+public:
+    virtual ~AudioIO() = default;
+
+    /**
+     * Capture block at AudioConfig::sample_rate
+     */
+    virtual void onCapture(const float* input, size_t frames, const BlockStatus& status) = 0;
+
+    /**
+     * Fill a playback block at AudioConfig::output_sample_rate
+     */
+    virtual void onRender(float* output, size_t frames, const BlockStatus& status) = 0;
+
+    /**
+     * Both directions in one block at AudioConfig::sample_rate
+     * (AudioConfig::full_duplex). The engine sets timing.frame_index.
+     */
+    virtual void onDuplex(const float* input, float* output, size_t frames,
+                          const BlockTiming& timing, const BlockStatus& status) = 0;
+
+    /**
+     * @return true while queued playback has not been rendered yet
+     */
+    virtual bool playbackPending() const = 0;
+};
+
+/**
+ * Stream source and sink for AudioEngine
+ */
+class AudioBackend {
+public:
+    virtual ~AudioBackend() = default;
+
+    /**
+     * Acquire the host API or input media; called once
+     */
+    virtual bool initialize(std::string& error) = 0;
+
+    /**
+     * Open the streams described by config. No AudioIO call may happen
+     * before start(), so the engine can size and lock its buffers first.
+     */
+    virtual bool open(const AudioConfig& config, AudioIO& io, std::string& error) = 0;
+
+    /**
+     * @return Latencies of the open streams
+     */
+    virtual BackendLatency latency() const = 0;
+
+    /**
+     * Begin calling the AudioIO passed to open()
+     */
+    virtual bool start(std::string& error) = 0;
+
+    /**
+     * Stop and close the streams. No AudioIO call is in flight on return.
+     */
+    virtual void close() = 0;
+
+    /**
+     * @return false once a finite source has been played out
+     */
+    virtual bool isActive() const { return true; }
+
+    /**
+     * @return Name of the configured (or default) input or output
+     */
+    virtual std::string deviceName(const AudioConfig& config, bool input) const = 0;
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,141 @@
+/**
+ * AudioEngineTypes.hpp - Public value types shared by AudioEngine callbacks
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace rtv::audio {
+
+/**
+ * Timing for one full-duplex block, taken from PaStreamCallbackTimeInfo.
+ *
+ * All times are in seconds on the stream clock (Pa_GetStreamTime), so
+ * output_dac_time - input_adc_time is the exact render-to-capture offset
+ * of the samples delivered in the same callback.
+ */
+struct BlockTiming {
+    double input_adc_time = 0.0;   // When the first input sample hit the ADC
+    double output_dac_time = 0.0;  // When the first output sample will hit the DAC
+    double current_time = 0.0;     // Stream time at callback entry
+    uint64_t frame_index = 0;      // Frames delivered since start()
+};
+
+/**
+ * Full-duplex block callback (runs on the real-time audio thread).
+ *
+ * Buffers are the device's raw interleaved blocks: input carries
+ * AudioConfig::capture_channels samples per frame (every mic, before echo
+ * cancellation or beamforming) and output AudioConfig::channels.
+ *
+ * @param input   Captured frames at AudioConfig::sample_rate, interleaved
+ * @param output  Frames being written to the device in the same block, interleaved
+ * @param frames  Frames (not samples) in both buffers
+ * @param timing  Stream timestamps for this block
+ */
+using DuplexCallback = std::function<void(
+    const float* input, const float* output, size_t frames, const BlockTiming& timing)>;
+
+/**
+ * Observer for the echo canceller's inputs (runs on the capture thread).
+ *
+ * Called once per capture block while an AudioPipeline is attached, with
+ * the render reference just fed to AEC3 and the raw capture about to be
+ * processed, both at AudioConfig::sample_rate. Offsets between the two
+ * streams are exactly the delay AEC3 has to model. Blocks longer than
+ * frames_per_buffer arrive in pieces; the reference comes with the first.
+ */
+using EchoPathObserver = std::function<void(
+    const float* reference, size_t reference_count,
+    const float* capture, size_t capture_count)>;
+
+/**
+ * Log2-bucketed histogram of durations in microseconds.
+ *
+ * Bucket 0 counts durations below 1us, bucket i counts [2^(i-1), 2^i) us,
+ * and the last bucket is open-ended (>= ~16ms).
+ */
+struct LatencyHistogram {
+    static constexpr size_t kBuckets = 16;
+    
+    std::array<uint64_t, kBuckets> counts{};
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+    
+    uint64_t samples() const {
+        uint64_t n = 0;
+        for (uint64_t c : counts) n += c;
+        return n;
+    }
+    
+    double mean_us() const {
+        uint64_t n = samples();
+        return n > 0 ? static_cast<double>(total_us) / n : 0.0;
+    }
+    
+    /**
+     * Upper bound (us) of the bucket containing the p-th percentile, p in [0, 1]
+     */
+    uint64_t percentile_us(double p) const {
+        uint64_t n = samples();
+        if (n == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(p * n);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen > target) {
+                return i + 1 < kBuckets ? (uint64_t{1} << i) : max_us;
+            }
+        }
+        return max_us;
+    }
+};
+
+/**
+ * Counters for one PortAudio stream direction
+ */
+struct StreamStats {
+    uint64_t callbacks = 0;
+    uint64_t frames = 0;
+    uint64_t overflows = 0;        // paInputOverflow / paOutputOverflow
+    uint64_t underflows = 0;       // paInputUnderflow / paOutputUnderflow
+    LatencyHistogram callback_time;  // Wall time spent inside the callback
+    double device_latency_ms = 0.0;  // Pa_GetStreamInfo input/output latency
+    size_t ring_occupancy = 0;     // Samples queued in this direction's ring
+    size_t ring_capacity = 0;      // 0 when the queue is unbounded
+    
+    uint64_t xruns() const { return overflows + underflows; }
+};
+
+/**
+ * Snapshot returned by AudioEngine::getStats()
+ */
+struct AudioStats {
+    StreamStats input;
+    StreamStats output;
+    LatencyHistogram processing_time;  // User callback time on the capture thread
+    uint64_t capture_ring_overruns = 0;  // Blocks the capture thread fell behind on
+    uint64_t duplex_blocks_skipped = 0;  // Duplex callback blocks missed while it was being replaced
+};
+
+/**
+ * Outcome of AudioConfig::realtime, returned by AudioEngine::realtimeStatus().
+ * Callback threads are promoted on their first callback, so poll after start().
+ */
+struct RealtimeStatus {
+    bool requested = false;
+    bool capture_thread = false;   // Threaded-capture worker runs SCHED_FIFO/RR
+    bool input_callback = false;   // PortAudio input (or duplex) callback thread
+    bool output_callback = false;  // PortAudio output callback thread
+    bool pipeline_worker = false;  // Attached AudioPipeline's worker thread (worker mode)
+    bool memory_locked = false;    // Engine buffers and the attached AudioPipeline are mlock()ed
+    size_t locked_bytes = 0;
+    std::string error;             // First failure reason, if any
+};
+
+} // namespace rtv::audio
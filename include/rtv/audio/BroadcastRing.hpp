@@ -0,0 +1,215 @@
+/**
+ * BroadcastRing.hpp - Lock-free single-producer/multi-consumer broadcast ring
+ *
+ * Fans one stream (e.g. capture) out to several stages that each read every
+ * sample at their own pace. The producer never blocks: it overwrites the
+ * oldest samples, and a consumer that falls more than a ring behind skips
+ * forward and records the loss instead of stalling everyone else.
+ */
+
+#pragma once
+
+#include "rtv/audio/RingBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace rtv::audio {
+
+/**
+ * SPMC broadcast ring with per-consumer cursors.
+ *
+ * Producer side: publish(). Consumer side: subscribe() once, then use the
+ * returned id from a single thread with read() or peek()/release().
+ *
+ * Reads are validated seqlock-style: the producer announces how far it is
+ * about to write before touching storage, and a consumer re-checks that
+ * mark after copying. A read that raced with an overwrite is discarded and
+ * counted as an overrun rather than returned torn.
+ */
+template <typename T>
+class BroadcastRing {
+public:
+    static constexpr int kMaxConsumers = 8;
+
+    using ReadRegions = RingRegions<const T>;
+
+    explicit BroadcastRing(size_t capacity)
+        : buffer_(capacity)
+        , capacity_(capacity)
+    {}
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // ---- Producer ----
+
+    /**
+     * Append samples, overwriting the oldest ones if any consumer lags.
+     * Never blocks and never fails.
+     */
+    void publish(const T* data, size_t count) {
+        // Only the newest capacity_ samples can survive this call
+        if (count > capacity_) {
+            size_t skip = count - capacity_;
+            const uint64_t head = head_.load(std::memory_order_relaxed) + skip;
+            reserve_.store(head, std::memory_order_relaxed);
+            head_.store(head, std::memory_order_release);
+            data += skip;
+            count = capacity_;
+        }
+
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        reserve_.store(head + count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const size_t pos = static_cast<size_t>(head % capacity_);
+        const size_t n1 = std::min(count, capacity_ - pos);
+        std::copy_n(data, n1, buffer_.data() + pos);
+        std::copy_n(data + n1, count - n1, buffer_.data());
+
+        head_.store(head + count, std::memory_order_release);
+    }
+
+    /**
+     * Total samples ever published
+     */
+    uint64_t written() const { return head_.load(std::memory_order_acquire); }
+
+    // ---- Registration (any thread) ----
+
+    /**
+     * Claim a consumer slot. The cursor starts at the current head, so the
+     * consumer sees only samples published from now on.
+     * @return Consumer id, or -1 if all slots are taken
+     */
+    int subscribe() {
+        for (int id = 0; id < kMaxConsumers; ++id) {
+            bool expected = false;
+            if (cursors_[id].active.compare_exchange_strong(expected, true)) {
+                cursors_[id].position.store(written(), std::memory_order_relaxed);
+                cursors_[id].dropped.store(0, std::memory_order_relaxed);
+                return id;
+            }
+        }
+        return -1;
+    }
+
+    void unsubscribe(int id) {
+        if (valid(id)) cursors_[id].active.store(false, std::memory_order_release);
+    }
+
+    // ---- Consumer (one thread per id) ----
+
+    /**
+     * Samples ready for this consumer (capped at the ring size)
+     */
+    size_t available(int id) const {
+        if (!valid(id)) return 0;
+        uint64_t lag = written() - cursors_[id].position.load(std::memory_order_relaxed);
+        return static_cast<size_t>(std::min<uint64_t>(lag, capacity_));
+    }
+
+    /**
+     * Copy up to count samples
+     * @return Samples copied; 0 if nothing is ready or the copy was overwritten
+     */
+    size_t read(int id, T* out, size_t count) {
+        ReadRegions r = peek(id, count);
+        std::copy_n(r.first.data(), r.first.size(), out);
+        std::copy_n(r.second.data(), r.second.size(), out + r.first.size());
+        return release(id, r.size()) ? r.size() : 0;
+    }
+
+    /**
+     * View up to count samples in place. The view is only trustworthy if
+     * the following release() returns true.
+     */
+    ReadRegions peek(int id, size_t count = std::numeric_limits<size_t>::max()) {
+        if (!valid(id)) return {};
+        Cursor& c = cursors_[id];
+
+        uint64_t pos = c.position.load(std::memory_order_relaxed);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        skipOverwritten(c, pos);
+
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(count, head - pos));
+        const size_t start = static_cast<size_t>(pos % capacity_);
+        const size_t n1 = std::min(n, capacity_ - start);
+        return {
+            std::span<const T>(buffer_.data() + start, n1),
+            std::span<const T>(buffer_.data(), n - n1)
+        };
+    }
+
+    /**
+     * Advance past count samples from the last peek()
+     * @return false if the producer overwrote any of them meanwhile; the
+     *         cursor then moves to the oldest intact sample
+     */
+    bool release(int id, size_t count) {
+        if (!valid(id)) return false;
+        Cursor& c = cursors_[id];
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t pos = c.position.load(std::memory_order_relaxed);
+        if (skipOverwritten(c, pos)) return false;
+
+        c.position.store(pos + count, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Samples this consumer has lost to overruns
+     */
+    uint64_t dropped(int id) const {
+        return valid(id) ? cursors_[id].dropped.load(std::memory_order_relaxed) : 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) Cursor {
+        std::atomic<uint64_t> position{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> active{false};
+    };
+
+    bool valid(int id) const {
+        return id >= 0 && id < kMaxConsumers &&
+               cursors_[id].active.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Move pos past anything the producer has overwritten or is writing
+     * @return true if the cursor had to skip
+     */
+    bool skipOverwritten(Cursor& c, uint64_t& pos) {
+        const uint64_t reserve = reserve_.load(std::memory_order_relaxed);
+        const uint64_t oldest = (reserve > capacity_) ? reserve - capacity_ : 0;
+        if (pos >= oldest) return false;
+
+        c.dropped.fetch_add(oldest - pos, std::memory_order_relaxed);
+        pos = oldest;
+        c.position.store(pos, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Producer line: published end and the end of the write in progress
+    alignas(kCacheLine) std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> reserve_{0};
+
+    std::array<Cursor, kMaxConsumers> cursors_;
+
+    alignas(kCacheLine) std::vector<T> buffer_;
+    size_t capacity_;
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,111 @@
+/**
+ * Deinterleave.hpp - Split interleaved multi-channel capture into planes
+ *
+ * PortAudio delivers mic arrays interleaved (c0 c1 c2 c3 c0 c1 ...), while
+ * AEC3 and the beamformer work on one contiguous buffer per channel. The
+ * 2- and 4-channel layouts, which cover stereo mics and the usual arrays,
+ * use AVX2 transposes when built with it; other counts use a scalar loop.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RTV_DEINTERLEAVE_AVX2 1
+#endif
+
+namespace rtv::audio {
+
+namespace detail {
+
+inline void deinterleaveScalar(const float* in, size_t frames, int channels,
+                               float* const* out, size_t start) {
+    for (size_t i = start; i < frames; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            out[c][i] = in[i * channels + c];
+        }
+    }
+}
+
+#ifdef RTV_DEINTERLEAVE_AVX2
+
+/**
+ * Two frames of 4 floats per 256-bit register, split by 128-bit lane
+ */
+inline __m256 loadLanes(const float* lo, const float* hi) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+/**
+ * @return Frames handled (a multiple of 8)
+ */
+inline size_t deinterleave4(const float* in, size_t frames, float* const* out) {
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const float* p = in + i * 4;
+        // Lane 0 holds frames i..i+3, lane 1 frames i+4..i+7
+        __m256 a = loadLanes(p + 0, p + 16);
+        __m256 b = loadLanes(p + 4, p + 20);
+        __m256 c = loadLanes(p + 8, p + 24);
+        __m256 d = loadLanes(p + 12, p + 28);
+
+        // 4x4 transpose inside each lane
+        __m256 t0 = _mm256_unpacklo_ps(a, b);
+        __m256 t1 = _mm256_unpackhi_ps(a, b);
+        __m256 t2 = _mm256_unpacklo_ps(c, d);
+        __m256 t3 = _mm256_unpackhi_ps(c, d);
+
+        _mm256_storeu_ps(out[0] + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+        _mm256_storeu_ps(out[1] + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+        _mm256_storeu_ps(out[2] + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+        _mm256_storeu_ps(out[3] + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+    return i;
+}
+
+/**
+ * @return Frames handled (a multiple of 8)
+ */
+inline size_t deinterleave2(const float* in, size_t frames, float* const* out) {
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i * 2);
+        __m256 y = _mm256_loadu_ps(in + i * 2 + 8);
+
+        // Per lane: even (left) and odd (right) samples, then fix lane order
+        __m256 left = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 right = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1));
+        left = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(left), _MM_SHUFFLE(3, 1, 2, 0)));
+        right = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(right), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        _mm256_storeu_ps(out[0] + i, left);
+        _mm256_storeu_ps(out[1] + i, right);
+    }
+    return i;
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * out[c][i] = in[i * channels + c] for every frame i and channel c
+ */
+inline void deinterleave(const float* in, size_t frames, int channels, float* const* out) {
+    if (channels == 1) {
+        std::copy_n(in, frames, out[0]);
+        return;
+    }
+
+    size_t done = 0;
+#ifdef RTV_DEINTERLEAVE_AVX2
+    if (channels == 4) done = detail::deinterleave4(in, frames, out);
+    else if (channels == 2) done = detail::deinterleave2(in, frames, out);
+#endif
+    detail::deinterleaveScalar(in, frames, channels, out, done);
+}
+
+} // namespace rtv::audio
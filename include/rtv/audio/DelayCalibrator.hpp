@@ -0,0 +1,88 @@
+/**
+ * DelayCalibrator.hpp - Speaker-to-microphone delay measurement for AEC3
+ *
+ * Plays a short chirp through AudioEngine, records the render reference
+ * and the raw capture exactly as AEC3 would see them, and finds the delay
+ * between the two by cross-correlation. The result seeds AEC3 through
+ * AudioPipeline::setDelayHint() and can be stored per device pair so the
+ * chirp only has to play once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rtv::audio {
+
+class AudioEngine;
+class AudioPipeline;
+
+/**
+ * Outcome of one calibration (or one loaded from disk)
+ */
+struct DelayCalibration {
+    int delay_ms = 0;          // Hint handed to AEC3
+    bool measured = false;     // Chirp was found; otherwise delay_ms is the PortAudio estimate
+    double measured_ms = 0.0;  // Render-to-capture delay from cross-correlation
+    double reported_ms = 0.0;  // PortAudio input + output latency
+    float confidence = 0.0f;   // Normalised correlation at the peak, 0..1
+};
+
+struct DelayCalibratorConfig {
+    int chirp_ms = 250;
+    float chirp_start_hz = 300.0f;
+    float chirp_end_hz = 6000.0f;    // Capped below the capture Nyquist rate
+    float chirp_level = 0.25f;       // Peak amplitude (-12 dBFS)
+    int max_delay_ms = 500;          // Longest delay searched
+    float min_confidence = 0.3f;     // Below this, fall back to PortAudio latencies
+};
+
+class DelayCalibrator {
+public:
+    explicit DelayCalibrator(const DelayCalibratorConfig& config = DelayCalibratorConfig());
+
+    /**
+     * Measure the delay and apply it to the pipeline.
+     * The engine must be running with pipeline attached as its echo
+     * canceller. Blocks for roughly chirp_ms + max_delay_ms + output latency.
+     * @return false if nothing could be recorded; result is still filled
+     *         with the PortAudio estimate and applied
+     */
+    bool calibrate(AudioEngine& engine, AudioPipeline& pipeline, DelayCalibration& result);
+
+    std::string lastError() const { return lastError_; }
+
+    /**
+     * Linear sweep from f0 to f1 with 5ms raised-cosine fades
+     */
+    static std::vector<float> makeChirp(int sample_rate, int duration_ms,
+                                        float f0, float f1, float level);
+
+    /**
+     * Lag (in samples, 0..max_lag) at which capture best matches reference
+     * @param confidence  Normalised correlation at that lag, 0..1
+     * @return -1 if the reference is silent or capture too short
+     */
+    static int findDelay(const float* reference, size_t reference_count,
+                         const float* capture, size_t capture_count,
+                         size_t max_lag, float* confidence = nullptr);
+
+    /**
+     * Key identifying the engine's input/output device pair
+     */
+    static std::string deviceKey(const AudioEngine& engine);
+
+    /**
+     * Per-device persistence in a small JSON file keyed by deviceKey()
+     */
+    static bool load(const std::string& path, const std::string& device_key, DelayCalibration& result);
+    static bool save(const std::string& path, const std::string& device_key, const DelayCalibration& result);
+
+private:
+    DelayCalibratorConfig config_;
+    std::string lastError_;
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,124 @@
+/**
+ * Endpointer.hpp - Adaptive end-of-turn detection
+ *
+ * Decides when the user has finished talking from the VAD decision
+ * stream. Instead of one fixed silence timeout, the wait follows how
+ * long this speaker actually pauses mid-sentence and, when a partial
+ * transcript is available, is shortened after a finished sentence or
+ * held open after a trailing "and"/"e". Without a transcript the wait
+ * never exceeds max_timeout_ms, the old fixed timeout.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace rtv::audio {
+
+struct EndpointerConfig {
+    int default_timeout_ms = 500;  // Until enough pauses have been measured
+    int min_timeout_ms = 200;
+    int max_timeout_ms = 500;      // Learned pauses only ever shorten the wait
+    float pause_margin = 2.0f;     // Timeout = pause mean + margin * stddev (at least 100ms)
+};
+
+/**
+ * How a partial transcript of the current turn ends
+ */
+enum class TranscriptHint {
+    None,        // No transcript, or nothing conclusive
+    Complete,    // Ends a sentence ('.', '?', '!')
+    Incomplete,  // Trailing comma, ellipsis, conjunction or filler
+};
+
+/**
+ * One finished turn
+ */
+struct EndpointInfo {
+    int delay_ms = 0;     // Silence between the last speech frame and the endpoint
+    int timeout_ms = 0;   // Timeout in force when the endpoint fired
+    int speech_ms = 0;    // Speech in the turn (pauses excluded)
+    TranscriptHint hint = TranscriptHint::None;
+};
+
+/**
+ * Statistics over committed turns; rejected segments are not counted
+ */
+struct EndpointerStats {
+    uint64_t turns = 0;
+    uint64_t early_turns = 0;    // Ended early on a complete transcript
+    double mean_delay_ms = 0.0;
+    int min_delay_ms = 0;
+    int max_delay_ms = 0;
+    double pause_mean_ms = 0.0;  // Learned in-turn pause statistics
+    double pause_stddev_ms = 0.0;
+    uint64_t pauses = 0;
+};
+
+/**
+ * Fed one VAD decision per frame. Not thread-safe: owned by the thread
+ * that runs VAD.
+ */
+class Endpointer {
+public:
+    explicit Endpointer(const EndpointerConfig& config = EndpointerConfig());
+
+    void setConfig(const EndpointerConfig& config);
+    const EndpointerConfig& config() const { return config_; }
+
+    /**
+     * Advance by one frame of duration_ms
+     * @return true once per turn, on the frame that ends it
+     */
+    bool update(bool speech, int duration_ms);
+
+    /**
+     * Report whether the turn update() just ended was delivered. Only
+     * accepted turns enter the statistics.
+     */
+    void commitTurn(bool accepted);
+
+    /**
+     * Latest partial transcript of the current turn (cleared per turn)
+     */
+    void setPartialTranscript(const std::string& text);
+    static TranscriptHint classify(const std::string& text);
+
+    /**
+     * Silence that would end the current turn right now
+     */
+    int currentTimeoutMs() const;
+
+    bool inTurn() const { return in_turn_; }
+    int trailingSilenceMs() const { return silence_ms_; }
+
+    const EndpointInfo& lastEndpoint() const { return last_; }
+    EndpointerStats stats() const;
+
+    /**
+     * Abandon the current turn; learned pause statistics are kept
+     */
+    void reset();
+
+private:
+    void learnPause(int pause_ms);
+
+    EndpointerConfig config_;
+
+    bool in_turn_ = false;
+    int speech_ms_ = 0;
+    int silence_ms_ = 0;
+    TranscriptHint hint_ = TranscriptHint::None;
+
+    // Exponentially weighted pause statistics
+    uint64_t pauses_ = 0;
+    double pause_mean_ = 0.0;
+    double pause_var_ = 0.0;
+
+    EndpointInfo last_;
+    EndpointerStats stats_;
+    double delay_total_ = 0.0;
+};
+
+} // namespace rtv::audio
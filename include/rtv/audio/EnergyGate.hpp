@@ -0,0 +1,117 @@
+/**
+ * EnergyGate.hpp - Cheap level pre-gate for the speech detectors
+ *
+ * libfvad and Porcupine run on every frame even through hours of room
+ * silence. The gate measures each int16 frame's RMS level and zero-crossing
+ * rate (AVX2 when available) against an adaptive noise floor and only lets
+ * frames that could be speech through to the detector. The last few
+ * skipped frames are kept and replayed when the gate opens, so a soft
+ * onset still reaches the detector and detection is not delayed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rtv::audio {
+
+struct EnergyGateConfig {
+    float open_db = 9.0f;          // Level above the noise floor that opens the gate
+    float fricative_db = 4.0f;     // Lower margin for noise-like frames (/s/, /f/ onsets)
+    float fricative_zcr = 0.25f;   // Zero crossings per sample counted as noise-like
+    float min_floor_dbfs = -70.0f; // Floor never adapts below this (digital silence)
+    int hangover_ms = 300;         // Stay open this long after the last loud frame
+    int lookback_ms = 100;         // Skipped audio replayed when the gate opens
+};
+
+struct EnergyGateStats {
+    uint64_t frames = 0;
+    uint64_t skipped = 0;        // Frames the detector never saw
+    float noise_floor_dbfs = 0.0f;
+
+    double skippedFraction() const {
+        return frames > 0 ? static_cast<double>(skipped) / frames : 0.0;
+    }
+};
+
+/**
+ * Level and zero-crossing rate of one frame
+ */
+struct FrameLevel {
+    float dbfs = -120.0f;  // RMS relative to int16 full scale
+    float zcr = 0.0f;      // Sign changes per sample
+};
+
+FrameLevel measureLevel(const int16_t* frame, size_t count);
+
+/**
+ * Owned by the thread that runs the detector; not thread-safe.
+ */
+class EnergyGate {
+public:
+    /**
+     * @param frame_size   Samples per detector frame
+     * @param sample_rate  Sample rate of the stream
+     */
+    EnergyGate(size_t frame_size, int sample_rate,
+               const EnergyGateConfig& config = EnergyGateConfig());
+
+    /**
+     * Gate one frame. When the frame passes, run(const int16_t* frame) is
+     * called for the held-back lookback frames (oldest first) and then for
+     * the frame itself; otherwise the frame is held back.
+     * @return true if the frame reached the detector
+     */
+    template <typename Run>
+    bool process(const int16_t* frame, Run&& run) {
+        if (!admit(frame)) {
+            remember(frame);
+            return false;
+        }
+        for (size_t i = 0; i < held_; ++i) {
+            run(lookbackFrame(i));
+        }
+        stats_.skipped -= held_;
+        held_ = 0;
+        run(frame);
+        return true;
+    }
+
+    bool isOpen() const { return hangover_left_ > 0; }
+    float noiseFloorDbfs() const { return floor_dbfs_; }
+    size_t frameSize() const { return frame_size_; }
+
+    EnergyGateStats stats() const;
+
+    /**
+     * Drop the held-back frames and close the gate; the learned noise
+     * floor and the statistics are kept
+     */
+    void reset();
+
+private:
+    bool admit(const int16_t* frame);
+    void remember(const int16_t* frame);
+    const int16_t* lookbackFrame(size_t i) const;
+
+    EnergyGateConfig config_;
+    size_t frame_size_;
+    float frame_s_;
+    int hangover_frames_;
+
+    bool primed_ = false;      // Floor seeded from the first frame
+    float floor_dbfs_ = 0.0f;
+    int hangover_left_ = 0;
+
+    // Lookback ring of whole frames
+    std::vector<int16_t> lookback_;
+    size_t lookback_frames_;
+    size_t next_ = 0;
+    size_t held_ = 0;
+
+    EnergyGateStats stats_;
+};
+
+} // namespace rtv::audio
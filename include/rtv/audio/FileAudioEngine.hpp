@@ -0,0 +1,139 @@
+/**
+ * FileAudioEngine.hpp - Hardware-free AudioEngine backend
+ *
+ * Reads microphone input from a WAV file and writes playback to a WAV file.
+ * FileAudioBackend stands in for the sound card underneath AudioEngine, so
+ * echo cancellation, the render tap, beamforming, the capture broadcast and
+ * telemetry all run exactly as they do on a device. Runs either paced in
+ * real time or on a virtual clock as fast as the pipeline allows.
+ */
+
+#pragma once
+
+#include "rtv/audio/AudioBackend.hpp"
+#include "rtv/audio/AudioEngine.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace rtv::audio {
+
+/**
+ * How the file backend advances time
+ */
+enum class ClockMode {
+    Realtime,   // One block per buffer period, like a sound card
+    Virtual     // Back-to-back blocks; time only advances with processed audio
+};
+
+/**
+ * File backend configuration
+ */
+struct FileAudioConfig {
+    std::string input_wav;           // Mic input (mono or downmixed)
+    std::string output_wav;          // Playback sink (empty = discard)
+    int sample_rate = 16000;         // Must match input_wav
+    int output_sample_rate = 24000;  // Playback/output WAV rate
+    int frames_per_buffer = 512;
+    bool full_duplex = false;        // One block per tick for both directions, output at sample_rate
+    ClockMode clock = ClockMode::Virtual;
+    bool loop_input = false;         // Restart input at EOF instead of finishing
+    int drain_timeout_ms = 0;        // Keep clocking silence after EOF until playback drains
+};
+
+/**
+ * WAV files and a clock thread in place of PortAudio streams. Each tick
+ * renders one playback period, then captures one input block, so the
+ * render tap always holds the reference for the echo in that block.
+ */
+class FileAudioBackend : public AudioBackend {
+public:
+    explicit FileAudioBackend(const FileAudioConfig& config);
+    ~FileAudioBackend() override;
+    
+    FileAudioBackend(const FileAudioBackend&) = delete;
+    FileAudioBackend& operator=(const FileAudioBackend&) = delete;
+    
+    /**
+     * Load the input WAV
+     */
+    bool initialize(std::string& error) override;
+    
+    /**
+     * Open the output WAV at the rate the engine renders
+     */
+    bool open(const AudioConfig& config, AudioIO& io, std::string& error) override;
+    BackendLatency latency() const override { return {}; }
+    
+    /**
+     * Start clocking blocks on a background thread
+     */
+    bool start(std::string& error) override;
+    
+    /**
+     * Stop the clock thread and finalize the output WAV
+     */
+    void close() override;
+    
+    /**
+     * @return true until the input is exhausted (and playback drained) or close()
+     */
+    bool isActive() const override;
+    
+    /**
+     * @return The WAV path for the direction
+     */
+    std::string deviceName(const AudioConfig& config, bool input) const override;
+    
+    /**
+     * Block until the clock thread has played out the input
+     */
+    void wait();
+    
+    /**
+     * @return Seconds of input delivered so far (the virtual clock)
+     */
+    double streamTime() const;
+    
+    /**
+     * @return Input frames delivered to the engine
+     */
+    uint64_t framesProcessed() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+/**
+ * AudioEngine on a FileAudioBackend. Usable anywhere an AudioEngine is
+ * (Orchestrator, DelayCalibrator), plus helpers for driving whole files.
+ */
+class FileAudioEngine : public AudioEngine {
+public:
+    explicit FileAudioEngine(const FileAudioConfig& config);
+    
+    /**
+     * Run the whole input through the engine and return once it has been
+     * played out. Deterministic when threaded capture is off and the
+     * callback does its work synchronously.
+     * @return false if the engine could not start
+     */
+    bool runToCompletion();
+    
+    /**
+     * @return Seconds of input delivered so far (the virtual clock)
+     */
+    double streamTime() const;
+    
+    /**
+     * @return Input frames delivered to the engine
+     */
+    uint64_t framesProcessed() const;
+    
+private:
+    FileAudioBackend& files() const;
+};
+
+} // namespace rtv::audio
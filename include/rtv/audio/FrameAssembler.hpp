@@ -0,0 +1,67 @@
+/**
+ * FrameAssembler.hpp - Fixed-capacity block-to-frame adapter
+ *
+ * Turns arbitrarily sized input blocks into fixed-size frames (e.g. the
+ * 10ms frames AEC3 and libfvad require) without allocating after
+ * construction. Whole frames are handed out straight from the caller's
+ * buffer; only the partial frame at a block edge is staged.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rtv::audio {
+
+class FrameAssembler {
+public:
+    explicit FrameAssembler(size_t frame_size)
+        : staging_(frame_size)
+    {}
+
+    /**
+     * Feed samples; onFrame(const float* frame) runs once per completed frame
+     * @return Number of frames emitted
+     */
+    template <typename OnFrame>
+    size_t push(const float* samples, size_t count, OnFrame&& onFrame) {
+        const size_t frame = staging_.size();
+        size_t frames = 0;
+
+        // Complete a frame started by an earlier block
+        if (fill_ > 0) {
+            size_t n = std::min(count, frame - fill_);
+            std::copy_n(samples, n, staging_.begin() + fill_);
+            fill_ += n;
+            samples += n;
+            count -= n;
+            if (fill_ < frame) return 0;
+            onFrame(static_cast<const float*>(staging_.data()));
+            fill_ = 0;
+            ++frames;
+        }
+
+        // Whole frames need no staging
+        for (; count >= frame; samples += frame, count -= frame) {
+            onFrame(samples);
+            ++frames;
+        }
+
+        std::copy_n(samples, count, staging_.begin());
+        fill_ = count;
+        return frames;
+    }
+
+    size_t frameSize() const { return staging_.size(); }
+    const float* staging() const { return staging_.data(); }
+    size_t pending() const { return fill_; }
+    void clear() { fill_ = 0; }
+
+private:
+    std::vector<float> staging_;
+    size_t fill_ = 0;
+};
+
+} // namespace rtv::audio
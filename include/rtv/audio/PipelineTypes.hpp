@@ -0,0 +1,131 @@
+/**
+ * PipelineTypes.hpp - Public value types reported by AudioPipeline
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtv::audio {
+
+/**
+ * Echo canceller health, returned by AudioPipeline::getMetrics().
+ *
+ * Refreshed from EchoCanceller3::GetMetrics() every metrics interval
+ * (AudioPipeline::setMetricsInterval) on the capture thread. Every field
+ * comes from the same refresh.
+ */
+struct AecMetrics {
+    double erle_db = 0.0;          // Echo return loss enhancement (AEC3)
+    double erl_db = 0.0;           // Echo return loss, render to capture (AEC3)
+    int delay_ms = 0;              // Estimated render-to-capture delay (AEC3)
+    float echo_likelihood = 0.0f;  // Share of capture energy removed as echo, 0..1
+    bool render_active = false;    // Reference signal was above the noise floor
+    bool echo_detected = false;    // render_active && echo_likelihood >= threshold
+    uint64_t frames = 0;           // 10ms capture frames processed so far
+    uint64_t updates = 0;          // Refreshes since construction or reset()
+};
+
+/**
+ * Capture processing stages, in the order AudioPipeline runs them
+ */
+enum class PipelineStage : int {
+    HighPass = 0,      // WebRTC HighPassFilter (DC and rumble removal)
+    EchoCancel,        // WebRTC EchoCanceller3, on every mic
+    Beamform,          // Delay-and-sum across the mic array (multi-channel only)
+    NoiseSuppress,     // WebRTC NoiseSuppressor
+    GainControl,       // Adaptive digital gain with a peak limiter
+};
+
+constexpr size_t kPipelineStages = 5;
+
+inline const char* stageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::HighPass:      return "HPF";
+        case PipelineStage::EchoCancel:    return "AEC3";
+        case PipelineStage::Beamform:      return "BF";
+        case PipelineStage::NoiseSuppress: return "NS";
+        case PipelineStage::GainControl:   return "AGC";
+    }
+    return "?";
+}
+
+/**
+ * Noise suppression strength (maximum attenuation of stationary noise)
+ */
+enum class NoiseSuppressionLevel {
+    Low,       // 6 dB
+    Moderate,  // 12 dB
+    High,      // 18 dB
+    VeryHigh,  // 21 dB
+};
+
+/**
+ * Capture chain layout: HPF -> AEC3 -> BF -> NS -> AGC. Every stage works
+ * in place on the same 10ms AudioBuffer; HPF and AEC3 run on every mic,
+ * the rest on the beamformed mono stream. Stages can also be toggled at
+ * runtime with AudioPipeline::setStageEnabled().
+ */
+struct PipelineConfig {
+    bool high_pass = true;
+    bool echo_cancellation = true;
+    bool beamforming = true;                 // Ignored with one mic
+    float beamformer_max_delay_ms = 0.5f;    // Largest inter-mic delay steered to
+    bool noise_suppression = true;
+    NoiseSuppressionLevel ns_level = NoiseSuppressionLevel::Moderate;
+    bool gain_control = false;
+    float agc_target_dbfs = -20.0f;  // Speech level the AGC steers towards
+    float agc_max_gain_db = 18.0f;   // Never boost more than this
+    
+    // Run the chain on its own thread instead of inside processCapture(),
+    // so its CPU cost never lands on the audio callback. Output then lags
+    // by the worker's queue; frames older than the deadline when the worker
+    // reaches them skip processing (first mic passed through).
+    bool worker_thread = false;
+    float worker_deadline_ms = 30.0f;
+};
+
+/**
+ * Time spent in one stage, measured on the capture thread
+ */
+struct StageStats {
+    bool available = false;  // Compiled in and constructed
+    bool enabled = false;    // Currently running
+    uint64_t frames = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    
+    double mean_us() const {
+        return frames > 0 ? total_ns / 1000.0 / frames : 0.0;
+    }
+};
+
+/**
+ * Snapshot returned by AudioPipeline::getStats()
+ */
+struct PipelineStats {
+    std::array<StageStats, kPipelineStages> stages;
+    uint64_t frames = 0;    // 10ms capture frames processed
+    
+    // Worker mode only
+    bool worker_thread = false;
+    uint64_t frames_late = 0;     // Passed through unprocessed (deadline missed)
+    uint64_t frames_dropped = 0;  // Lost to a full capture or output queue
+    
+    const StageStats& operator[](PipelineStage stage) const {
+        return stages[static_cast<size_t>(stage)];
+    }
+    
+    /**
+     * Share of real time spent processing (1.0 = one full core)
+     */
+    double load() const {
+        uint64_t ns = 0;
+        for (const StageStats& s : stages) ns += s.total_ns;
+        return frames > 0 ? ns / (frames * 10.0e6) : 0.0;
+    }
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,141 @@
+/**
+ * PlaybackMixer.hpp - Lock-free multi-source playback mixer
+ *
+ * Sources queue immutable, refcounted clips instead of copying samples into
+ * a fixed ring, so cached assets play with zero copies and response length
+ * is bounded only by memory.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rtv::audio {
+
+/**
+ * Immutable audio shared between the owner and the mixer
+ */
+using AudioClip = std::shared_ptr<const std::vector<float>>;
+
+/**
+ * Wrap samples in a clip (moves, does not copy)
+ */
+inline AudioClip makeClip(std::vector<float> samples) {
+    return std::make_shared<const std::vector<float>>(std::move(samples));
+}
+
+/**
+ * Mixes up to kMaxSources independent clip queues into one output stream.
+ *
+ * Clips on the same source play back to back; different sources overlap and
+ * are summed with per-source gain. enqueue()/clear()/setGain() may be called
+ * from any non-real-time thread. mix() is called from a single real-time
+ * thread and never locks, allocates or releases a clip; finished clips are
+ * released on the control side during the next enqueue().
+ *
+ * Each source hands at most kQueueDepth clips to the real-time side at a
+ * time. Clips beyond that wait on the control side and move into slots as
+ * they free up, during enqueue() and while waitForDrain() waits, so a
+ * source's queue is bounded only by memory.
+ */
+class PlaybackMixer {
+public:
+    static constexpr int kMaxSources = 4;
+    static constexpr size_t kQueueDepth = 64;  // Clips visible to mix() per source
+    
+    PlaybackMixer() = default;
+    
+    PlaybackMixer(const PlaybackMixer&) = delete;
+    PlaybackMixer& operator=(const PlaybackMixer&) = delete;
+    
+    /**
+     * Queue a clip after whatever is already queued on the source
+     * @return false if the source is invalid or the clip is empty
+     */
+    bool enqueue(AudioClip clip, int source = 0);
+    
+    /**
+     * Set the linear gain applied to a source (default 1.0)
+     */
+    void setGain(int source, float gain);
+    
+    /**
+     * Drop everything queued on a source, or on all sources when source < 0
+     */
+    void clear(int source = -1);
+    
+    /**
+     * @return true while any source has samples left to play
+     */
+    bool isActive() const;
+    
+    /**
+     * @return Samples still queued across all sources
+     */
+    size_t queuedSamples() const;
+    
+    /**
+     * @return Frames of queued audio mixed into the output since construction
+     */
+    uint64_t samplesPlayed() const;
+    
+    /**
+     * Block until every source has drained or the timeout expires.
+     * The real-time side signals the transition to empty from mix(); the wait
+     * re-checks at least every slice, so a missed wake-up costs at most that.
+     * Each check also moves waiting clips into free slots.
+     * @return true if nothing is queued
+     */
+    bool waitForDrain(std::chrono::milliseconds timeout,
+                      std::chrono::microseconds slice = std::chrono::milliseconds(10));
+    
+    /**
+     * Real-time side: overwrite out with the mix of all sources.
+     * @return Number of leading frames that carried queued audio
+     */
+    size_t mix(float* out, size_t frames);
+    
+private:
+    struct Entry {
+        const float* data = nullptr;
+        size_t size = 0;
+        AudioClip owner;  // Touched only by the control side
+    };
+    
+    struct Source {
+        std::array<Entry, kQueueDepth> entries;
+        std::atomic<uint64_t> write{0};     // Next slot to fill (control)
+        std::atomic<uint64_t> read{0};      // Clip being played (real-time)
+        std::atomic<uint64_t> flushTo{0};   // clear() target for the real-time side
+        std::atomic<size_t> queued{0};      // Samples not yet mixed, pending included
+        std::atomic<float> gain{1.0f};
+        size_t position = 0;                // Offset in current clip (real-time)
+        uint64_t reclaim = 0;               // Next clip to release (control)
+        std::deque<AudioClip> pending;      // Waiting for a free slot (control)
+    };
+    
+    void reclaimFinished(Source& src);
+    void promotePending(Source& src);
+    void refill();
+    size_t mixSource(Source& src, float* out, size_t frames, bool& slotsFreed);
+    
+    std::array<Source, kMaxSources> sources_;
+    std::mutex control_mutex_;
+    
+    // Drain signalling (notified without a lock from the real-time side)
+    std::atomic<uint64_t> played_{0};
+    bool was_active_ = false;  // Real-time side only
+    std::mutex drain_mutex_;
+    std::condition_variable drain_cv_;
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,41 @@
+/**
+ * PortAudioBackend.hpp - Sound card backend for AudioEngine
+ *
+ * Opens separate input and output streams, or one full-duplex stream, and
+ * forwards every PortAudio callback to the engine.
+ */
+
+#pragma once
+
+#include "rtv/audio/AudioBackend.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rtv::audio {
+
+class PortAudioBackend : public AudioBackend {
+public:
+    PortAudioBackend();
+    ~PortAudioBackend() override;
+
+    PortAudioBackend(const PortAudioBackend&) = delete;
+    PortAudioBackend& operator=(const PortAudioBackend&) = delete;
+
+    bool initialize(std::string& error) override;
+    bool open(const AudioConfig& config, AudioIO& io, std::string& error) override;
+    BackendLatency latency() const override;
+    bool start(std::string& error) override;
+    void close() override;
+    std::string deviceName(const AudioConfig& config, bool input) const override;
+
+    static std::vector<std::string> listInputDevices();
+    static std::vector<std::string> listOutputDevices();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace rtv::audio
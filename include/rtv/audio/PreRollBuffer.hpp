@@ -0,0 +1,73 @@
+/**
+ * PreRollBuffer.hpp - Fixed-length capture history
+ *
+ * Keeps the most recent N milliseconds of audio so a speech segment can
+ * start before the point where VAD first fired, instead of losing the
+ * first syllable.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rtv::audio {
+
+/**
+ * Overwrite-oldest history ring. write() never fails and never allocates;
+ * the oldest samples are discarded once the configured length is reached.
+ * Not thread-safe: owned by the thread that runs the capture path.
+ */
+class PreRollBuffer {
+public:
+    /**
+     * @param sample_rate  Sample rate of the stream
+     * @param duration_ms  History length (0 disables)
+     */
+    PreRollBuffer(int sample_rate, int duration_ms);
+
+    /**
+     * Change the history length; drops the current contents
+     */
+    void setDuration(int duration_ms);
+    int durationMs() const { return duration_ms_; }
+
+    /**
+     * Record samples, discarding the oldest beyond capacity
+     */
+    void write(const float* samples, size_t count);
+
+    /**
+     * Append the history to out, oldest sample first
+     */
+    void appendTo(std::vector<float>& out) const;
+
+    /**
+     * Call fn(const float* samples, size_t count) for each contiguous
+     * piece of the history, oldest first (at most two calls, no copy)
+     */
+    template <typename Fn>
+    void visit(Fn&& fn) const {
+        if (size_ == 0) return;
+        const size_t cap = buffer_.size();
+        const size_t start = (next_ + cap - size_) % cap;
+        const size_t n1 = std::min(size_, cap - start);
+        fn(buffer_.data() + start, n1);
+        if (size_ > n1) fn(buffer_.data(), size_ - n1);
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool empty() const { return size_ == 0; }
+    void clear();
+
+private:
+    int sample_rate_;
+    int duration_ms_ = 0;
+    std::vector<float> buffer_;
+    size_t next_ = 0;   // Slot for the next sample
+    size_t size_ = 0;   // Valid samples (<= capacity)
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,49 @@
+/**
+ * Realtime.hpp - Thread priority and memory locking helpers for the audio path
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace rtv::audio {
+
+/**
+ * Promote the calling thread to a real-time scheduling class.
+ *
+ * @param priority     Requested priority, clamped to the policy's range
+ * @param round_robin  Use SCHED_RR instead of SCHED_FIFO
+ * @param error        Optional reason on failure (e.g. missing CAP_SYS_NICE
+ *                     or RLIMIT_RTPRIO)
+ * @return true if the policy was granted
+ */
+bool promoteCurrentThread(int priority, bool round_robin = false, std::string* error = nullptr);
+
+/**
+ * Return the calling thread to normal (SCHED_OTHER) scheduling
+ */
+void demoteCurrentThread();
+
+/**
+ * Lock a memory range into RAM (mlock). Also faults every page in.
+ *
+ * Locks are counted per page, so ranges that share a page (small buffers
+ * from the same heap block) can be locked and unlocked independently.
+ * @return true on success (fails when RLIMIT_MEMLOCK is too small)
+ */
+bool lockMemory(const void* addr, size_t bytes);
+
+/**
+ * Undo lockMemory() for the same range. Pages another locked range still
+ * covers stay locked.
+ */
+void unlockMemory(const void* addr, size_t bytes);
+
+/**
+ * Touch every page of a writable range so the first real-time access
+ * does not take a page fault. Contents are preserved.
+ */
+void prefaultMemory(void* addr, size_t bytes);
+
+} // namespace rtv::audio
@@ -0,0 +1,92 @@
+/**
+ * Resampler.hpp - Polyphase windowed-sinc sample rate converter
+ *
+ * Converts between any two integer rates by a rational factor L/M. The
+ * inner loop is one dot product per output sample (AVX2/FMA when built
+ * with it), so the same converter is cheap enough for the real-time render
+ * path and accurate enough for assets and TTS output.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace rtv::audio {
+
+/**
+ * Streaming mono resampler.
+ *
+ * State carries across process() calls, so a stream may be fed in blocks of
+ * any size and produces the same samples as one call on the whole signal.
+ * process() never allocates; it is safe on a real-time thread.
+ */
+class Resampler {
+public:
+    static constexpr int kDefaultTaps = 32;  // Taps per phase when upsampling
+
+    /**
+     * @param input_rate   Source rate in Hz
+     * @param output_rate  Target rate in Hz
+     * @param taps_per_phase  Filter length per phase; scaled up by the
+     *                        decimation factor when downsampling
+     */
+    Resampler(int input_rate, int output_rate, int taps_per_phase = kDefaultTaps);
+    ~Resampler();
+
+    Resampler(Resampler&&) noexcept;
+    Resampler& operator=(Resampler&&) noexcept;
+
+    Resampler(const Resampler&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+
+    int inputRate() const;
+    int outputRate() const;
+
+    /**
+     * True when both rates are equal and samples are copied through
+     */
+    bool isPassthrough() const;
+
+    /**
+     * Upper bound on samples produced by process() for count inputs
+     */
+    size_t maxOutput(size_t count) const;
+
+    /**
+     * Filter group delay in output samples
+     */
+    double delay() const;
+
+    /**
+     * Convert the next block of the stream
+     * @param output  Must hold at least maxOutput(count) samples
+     * @return Samples written to output
+     */
+    size_t process(const float* input, size_t count, float* output);
+
+    /**
+     * Convenience overload that allocates the output
+     */
+    std::vector<float> process(const std::vector<float>& input);
+
+    /**
+     * Forget stream history (e.g. after a discontinuity)
+     */
+    void reset();
+
+    /**
+     * Convert a complete signal: flushes the filter tail and removes the
+     * group delay, so the result is time-aligned with the input and has
+     * round(size * output_rate / input_rate) samples.
+     */
+    static std::vector<float> convert(const std::vector<float>& input,
+                                      int input_rate, int output_rate);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace rtv::audio
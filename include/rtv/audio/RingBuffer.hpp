@@ -0,0 +1,289 @@
+/**
+ * RingBuffer.hpp - Lock-free single-producer/single-consumer ring buffer
+ *
+ * Used to hand samples between real-time audio callbacks and worker
+ * threads. Besides copying push()/pop(), the ring exposes its storage as
+ * up to two contiguous regions so either side can work in place, and lets
+ * either side block until the other has made progress.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace rtv::audio {
+
+namespace detail {
+
+/**
+ * Block while word == expected, until woken or timeout expires.
+ * Uses a futex on Linux; may return spuriously.
+ */
+void waitOnAddress(std::atomic<uint32_t>& word, uint32_t expected,
+                   std::chrono::nanoseconds timeout);
+
+/**
+ * Wake every thread blocked in waitOnAddress() on word
+ */
+void wakeAddress(std::atomic<uint32_t>& word);
+
+} // namespace detail
+
+/**
+ * Up to two contiguous pieces of ring storage, in stream order.
+ * second is empty unless the range wraps past the end of the buffer.
+ */
+template <typename U>
+struct RingRegions {
+    std::span<U> first;
+    std::span<U> second;
+
+    size_t size() const { return first.size() + second.size(); }
+    bool empty() const { return size() == 0; }
+};
+
+/**
+ * SPSC ring buffer holding up to `capacity` elements.
+ *
+ * Producer side: push(), acquire_write()/commit_write().
+ * Consumer side: pop(), peek_read()/consume(), clear(), wait_for_data().
+ * Producer may block in wait_for_space().
+ * available()/space()/wake() may be called from any thread.
+ *
+ * Head and tail live on separate cache lines, each next to the owning
+ * side's cached copy of the other index, so steady-state calls touch the
+ * shared line only when the cached view runs out.
+ *
+ * Waiting is futex-backed. A side only signals when the other has
+ * registered as a waiter, so the non-blocking fast path costs one fence
+ * and one load, and never a syscall or a lock.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    using WriteRegions = RingRegions<T>;
+    using ReadRegions = RingRegions<const T>;
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    explicit RingBuffer(size_t capacity)
+        : buffer_(capacity)
+        , capacity_(capacity)
+    {}
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // ---- Producer ----
+
+    /**
+     * Reserve up to count free slots for in-place writing
+     * @return Writable regions (may be smaller than count if the ring is full)
+     */
+    WriteRegions acquire_write(size_t count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t free = capacity_ - (head - cachedTail_);
+        if (free < count) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            free = capacity_ - (head - cachedTail_);
+        }
+        return regions<T>(head, std::min(count, free));
+    }
+
+    /**
+     * Publish count elements written into the last acquire_write() regions
+     */
+    void commit_write(size_t count) {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        notify(dataSignal_, dataWaiters_);
+    }
+
+    /**
+     * Copy in as many elements as fit
+     * @return Elements written
+     */
+    size_t push(const T* data, size_t count) {
+        WriteRegions r = acquire_write(count);
+        std::copy_n(data, r.first.size(), r.first.data());
+        std::copy_n(data + r.first.size(), r.second.size(), r.second.data());
+        commit_write(r.size());
+        return r.size();
+    }
+
+    // ---- Consumer ----
+
+    /**
+     * View up to count readable elements without removing them
+     */
+    ReadRegions peek_read(size_t count = std::numeric_limits<size_t>::max()) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t ready = cachedHead_ - tail;
+        if (ready < count) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            ready = cachedHead_ - tail;
+        }
+        return regions<const T>(tail, std::min(count, ready));
+    }
+
+    /**
+     * Release count elements previously returned by peek_read()
+     */
+    void consume(size_t count) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        notify(spaceSignal_, spaceWaiters_);
+    }
+
+    /**
+     * Copy out up to count elements
+     * @return Elements read
+     */
+    size_t pop(T* data, size_t count) {
+        ReadRegions r = peek_read(count);
+        std::copy_n(r.first.data(), r.first.size(), data);
+        std::copy_n(r.second.data(), r.second.size(), data + r.first.size());
+        consume(r.size());
+        return r.size();
+    }
+
+    /**
+     * Drop everything currently readable (consumer side, or while idle)
+     */
+    void clear() {
+        const size_t head = head_.load(std::memory_order_acquire);
+        cachedHead_ = head;
+        tail_.store(head, std::memory_order_release);
+        notify(spaceSignal_, spaceWaiters_);
+    }
+
+    /**
+     * Block until at least count elements are readable
+     * @return false on deadline or wake()
+     */
+    bool wait_for_data(size_t count, Deadline deadline) {
+        return waitUntil(dataSignal_, dataWaiters_, deadline,
+                         [&]() { return available() >= count; });
+    }
+
+    /**
+     * Block until at least count slots are free (producer side)
+     * @return false on deadline or wake()
+     */
+    bool wait_for_space(size_t count, Deadline deadline) {
+        return waitUntil(spaceSignal_, spaceWaiters_, deadline,
+                         [&]() { return space() >= count; });
+    }
+
+    /**
+     * Release every blocked waiter (e.g. on shutdown)
+     */
+    void wake() {
+        interrupts_.fetch_add(1, std::memory_order_release);
+        signal(dataSignal_);
+        signal(spaceSignal_);
+    }
+
+    // ---- Either side ----
+
+    /**
+     * Elements ready to read
+     */
+    size_t available() const {
+        // Tail first: head only grows, so the difference never underflows
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) - tail;
+    }
+
+    /**
+     * Free slots for writing
+     */
+    size_t space() const { return capacity_ - available(); }
+
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return available() == 0; }
+
+    /**
+     * The whole backing store, whatever its contents (for mlock)
+     */
+    std::span<const T> storage() const { return {buffer_.data(), buffer_.size()}; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    static void signal(std::atomic<uint32_t>& word) {
+        word.fetch_add(1, std::memory_order_release);
+        detail::wakeAddress(word);
+    }
+
+    /**
+     * Signal only if the other side is blocked. The fence pairs with the
+     * one in waitUntil(): either we see the waiter, or it sees our update.
+     */
+    static void notify(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            signal(word);
+        }
+    }
+
+    template <typename Ready>
+    bool waitUntil(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters,
+                   Deadline deadline, Ready ready) {
+        if (ready()) return true;
+
+        const uint32_t interrupts = interrupts_.load(std::memory_order_acquire);
+        waiters.fetch_add(1, std::memory_order_relaxed);
+
+        bool met = false;
+        while (true) {
+            // Read the word before the condition so a signal in between is not lost
+            const uint32_t seen = word.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) { met = true; break; }
+            if (interrupts_.load(std::memory_order_acquire) != interrupts) break;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) break;
+            detail::waitOnAddress(word, seen, deadline - now);
+        }
+
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return met;
+    }
+
+    template <typename U>
+    RingRegions<U> regions(size_t start, size_t count) {
+        const size_t pos = start % capacity_;
+        const size_t n1 = std::min(count, capacity_ - pos);
+        return {
+            std::span<U>(buffer_.data() + pos, n1),
+            std::span<U>(buffer_.data(), count - n1)
+        };
+    }
+
+    // Producer line: write index and the producer's view of the tail
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+
+    // Consumer line: read index and the consumer's view of the head
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+
+    // Wait/notify words, touched by the fast path only as a relaxed load
+    alignas(kCacheLine) std::atomic<uint32_t> dataSignal_{0};
+    std::atomic<uint32_t> dataWaiters_{0};
+    std::atomic<uint32_t> spaceSignal_{0};
+    std::atomic<uint32_t> spaceWaiters_{0};
+    std::atomic<uint32_t> interrupts_{0};
+
+    // Read-only after construction
+    alignas(kCacheLine) std::vector<T> buffer_;
+    size_t capacity_;
+};
+
+} // namespace rtv::audio
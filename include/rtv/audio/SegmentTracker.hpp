@@ -0,0 +1,74 @@
+/**
+ * SegmentTracker.hpp - Stream positions of VADProcessor speech segments
+ *
+ * SpeechEvents carry the segment's audio but not where it sits in the
+ * stream. Fed the events together with the stream position, this recovers
+ * each segment's boundaries: where its audio starts (pre-roll included),
+ * the first and last speech frames, and the endpoint.
+ */
+
+#pragma once
+
+#include "rtv/audio/VADTypes.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace rtv::audio {
+
+/**
+ * Segment boundaries in samples from the start of the stream
+ */
+struct SegmentBounds {
+    size_t start = 0;         // First sample delivered (pre-roll included)
+    size_t speech_start = 0;  // First speech frame
+    size_t speech_end = 0;    // End of the last speech frame
+    size_t end = 0;           // Endpoint: speech end plus the trailing silence
+};
+
+class SegmentTracker {
+public:
+    /**
+     * @param frame_samples  VADProcessor frame size
+     * @param sample_rate    Stream sample rate
+     */
+    SegmentTracker(size_t frame_samples, int sample_rate)
+        : frame_samples_(frame_samples), sample_rate_(sample_rate) {}
+
+    /**
+     * Feed one event from the speech event callback.
+     *
+     * @param position  Samples fed to VADProcessor so far, including the
+     *                  frame being processed when the event fired
+     * @return true when an accepted segment ended; see last()
+     */
+    bool onEvent(const SpeechEvent& event, size_t position) {
+        if (event.type == SpeechEventType::Start) {
+            // Start fires while the first speech frame is processed
+            onset_ = position - std::min(frame_samples_, position);
+            return false;
+        }
+        if (event.type != SpeechEventType::End || !event.accepted) return false;
+
+        // Everything delivered before the onset is the segment's pre-roll
+        const size_t length = event.offset + event.audio.size();
+        const size_t pre_roll = length - std::min(length, position - onset_);
+        const size_t delay = static_cast<size_t>(event.endpoint_delay_ms) * sample_rate_ / 1000;
+
+        last_.speech_start = onset_;
+        last_.start = onset_ - std::min(pre_roll, onset_);
+        last_.end = position;
+        last_.speech_end = std::max(onset_, position - std::min(delay, position));
+        return true;
+    }
+
+    const SegmentBounds& last() const { return last_; }
+
+private:
+    size_t frame_samples_;
+    int sample_rate_;
+    size_t onset_ = 0;
+    SegmentBounds last_;
+};
+
+} // namespace rtv::audio
@@ -0,0 +1,38 @@
+/**
+ * VADTypes.hpp - Streaming speech-segment events reported by VADProcessor
+ */
+
+#pragma once
+
+#include "rtv/audio/RingBuffer.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace rtv::audio {
+
+enum class SpeechEventType {
+    Start,  // First speech frame; no audio yet
+    Chunk,  // Next fixed-size piece of the segment (pre-roll included)
+    End,    // Trailing silence reached the timeout; audio is the remainder
+};
+
+/**
+ * One step of a speech segment, delivered as it happens.
+ *
+ * Concatenating the audio of every Chunk and the End event gives exactly
+ * the segment SpeechCallback would receive. audio points into
+ * VADProcessor's segment ring and is only valid during the callback.
+ */
+struct SpeechEvent {
+    SpeechEventType type = SpeechEventType::Start;
+    RingRegions<const float> audio;
+    size_t offset = 0;          // Segment samples delivered before this audio
+    int duration_ms = 0;        // Segment length up to the end of this audio
+    bool accepted = false;      // End only: speech met the minimum duration
+    int endpoint_delay_ms = 0;  // End only: trailing silence waited before ending
+};
+
+using SpeechEventCallback = std::function<void(const SpeechEvent& event)>;
+
+} // namespace rtv::audio
@@ -0,0 +1,67 @@
+/**
+ * WavFile.hpp - Minimal RIFF/WAVE reader and streaming writer
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace rtv::audio {
+
+/**
+ * Decoded WAV contents as interleaved float samples in [-1, 1].
+ */
+struct WavData {
+    std::vector<float> samples;
+    int sample_rate = 0;
+    int channels = 0;
+    
+    size_t frames() const { return channels > 0 ? samples.size() / channels : 0; }
+};
+
+/**
+ * Read a PCM (16/24/32-bit) or IEEE float (32-bit) WAV file.
+ *
+ * @param path   File to read
+ * @param out    Decoded samples and format
+ * @param error  Optional reason on failure
+ * @return true on success
+ */
+bool readWav(const std::string& path, WavData& out, std::string* error = nullptr);
+
+/**
+ * Downmix interleaved multi-channel samples to mono (no-op for mono).
+ */
+std::vector<float> downmixToMono(const WavData& wav);
+
+/**
+ * Streaming 32-bit float WAV writer. The header is patched on close(), so
+ * the file can grow while a benchmark runs.
+ */
+class WavWriter {
+public:
+    WavWriter() = default;
+    ~WavWriter();
+    
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+    
+    bool open(const std::string& path, int sample_rate, int channels = 1);
+    void write(const float* samples, size_t count);
+    void close();
+    
+    bool isOpen() const { return file_.is_open(); }
+    size_t samplesWritten() const { return samples_written_; }
+    
+private:
+    std::ofstream file_;
+    int sample_rate_ = 0;
+    int channels_ = 1;
+    size_t samples_written_ = 0;
+};
+
+} // namespace rtv::audio
@@ -1,30 +1,191 @@
 /**
- * AudioEngine.cpp - PortAudio wrapper implementation
+ * AudioEngine.cpp - Audio capture and playback engine
  * 
  * Provides low-latency audio capture and playback for the RTV voice assistant.
- * Uses PortAudio for cross-platform audio I/O.
+ * Device I/O comes from an AudioBackend: PortAudio for cross-platform sound
+ * cards by default, or WAV files (FileAudioEngine).
  */
 
 #include "rtv/audio/AudioEngine.hpp"
+#include "rtv/audio/AudioBackend.hpp"
+#include "rtv/audio/AudioEngineTypes.hpp"
+#include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/Beamformer.hpp"
+#include "rtv/audio/BroadcastRing.hpp"
+#include "rtv/audio/Deinterleave.hpp"
+#include "rtv/audio/PlaybackMixer.hpp"
+#include "rtv/audio/PortAudioBackend.hpp"
+#include "rtv/audio/Realtime.hpp"
+#include "rtv/audio/Resampler.hpp"
 #include "rtv/audio/RingBuffer.hpp"
 
-#include <portaudio.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace rtv::audio {
 
-// Playback buffer size (samples)
-constexpr size_t PLAYBACK_BUFFER_SIZE = 24000 * 10;  // 10 seconds at 24kHz
+// Capture hand-off (threaded capture) and broadcast depth
+constexpr size_t CAPTURE_BUFFER_SECONDS = 2;
+constexpr size_t CAPTURE_BUFFER_MIN_BLOCKS = 4;
 
-// Forward declare Impl for callbacks
-struct AudioEngineImpl {
-    PaStream* inputStream = nullptr;
-    PaStream* outputStream = nullptr;
+// Render tap size (samples at the rate the device is written)
+constexpr size_t RENDER_TAP_SIZE = 24000;  // 1 second at 24kHz
+
+/**
+ * Pull-driven wrapper around Resampler that yields exactly the requested
+ * number of frames per call. Used by the full-duplex stream (mixer rate ->
+ * stream rate) and by the render tap (device output rate -> capture rate
+ * for AEC3).
+ */
+struct RateConverter {
+    std::unique_ptr<Resampler> resampler;
+    double step = 1.0;    // Source samples per output sample
+    
+    std::vector<float> scratch;  // Pulled source block
+    std::vector<float> pending;  // Converted samples not yet handed out
+    size_t pendingLen = 0;
+    
+    void configure(int sourceRate, int targetRate, size_t maxFrames) {
+        resampler = std::make_unique<Resampler>(sourceRate, targetRate);
+        step = static_cast<double>(sourceRate) / targetRate;
+        scratch.assign(static_cast<size_t>(std::ceil(maxFrames * step)) + 2, 0.0f);
+        pending.assign(maxFrames + resampler->maxOutput(scratch.size()), 0.0f);
+        pendingLen = 0;
+    }
+    
+    /**
+     * @param pull  size_t(float* dst, size_t n), returns samples produced
+     */
+    template <typename Pull>
+    void render(Pull&& pull, float* out, size_t frames) {
+        while (pendingLen < frames) {
+            size_t want = static_cast<size_t>(std::ceil((frames - pendingLen) * step)) + 1;
+            size_t got = pull(scratch.data(), std::min(want, scratch.size()));
+            if (got == 0) break;
+            pendingLen += resampler->process(scratch.data(), got, pending.data() + pendingLen);
+        }
+        
+        size_t n = std::min(frames, pendingLen);
+        std::memcpy(out, pending.data(), n * sizeof(float));
+        std::fill(out + n, out + frames, 0.0f);
+        pendingLen -= n;
+        std::memmove(pending.data(), pending.data() + n, pendingLen * sizeof(float));
+    }
+};
+
+/**
+ * Lock-free accumulator behind LatencyHistogram. Written by one real-time
+ * thread, read by getStats() with relaxed loads.
+ */
+struct HistogramCounters {
+    std::array<std::atomic<uint64_t>, LatencyHistogram::kBuckets> counts{};
+    std::atomic<uint64_t> total_us{0};
+    std::atomic<uint64_t> max_us{0};
+    
+    void record(uint64_t us) {
+        size_t bucket = std::min<size_t>(std::bit_width(us), LatencyHistogram::kBuckets - 1);
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        total_us.fetch_add(us, std::memory_order_relaxed);
+        if (us > max_us.load(std::memory_order_relaxed)) {
+            max_us.store(us, std::memory_order_relaxed);
+        }
+    }
+    
+    LatencyHistogram snapshot() const {
+        LatencyHistogram h;
+        for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            h.counts[i] = counts[i].load(std::memory_order_relaxed);
+        }
+        h.total_us = total_us.load(std::memory_order_relaxed);
+        h.max_us = max_us.load(std::memory_order_relaxed);
+        return h;
+    }
+    
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        total_us.store(0, std::memory_order_relaxed);
+        max_us.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Per-direction stream counters updated from the PortAudio callbacks
+ */
+struct StreamCounters {
+    std::atomic<uint64_t> callbacks{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> overflows{0};
+    std::atomic<uint64_t> underflows{0};
+    HistogramCounters callbackTime;
+    std::atomic<double> latencyMs{0.0};
+    
+    void onCallback(unsigned long frameCount, bool overflow, bool underflow) {
+        callbacks.fetch_add(1, std::memory_order_relaxed);
+        frames.fetch_add(frameCount, std::memory_order_relaxed);
+        if (overflow) overflows.fetch_add(1, std::memory_order_relaxed);
+        if (underflow) underflows.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    StreamStats snapshot() const {
+        StreamStats s;
+        s.callbacks = callbacks.load(std::memory_order_relaxed);
+        s.frames = frames.load(std::memory_order_relaxed);
+        s.overflows = overflows.load(std::memory_order_relaxed);
+        s.underflows = underflows.load(std::memory_order_relaxed);
+        s.callback_time = callbackTime.snapshot();
+        s.device_latency_ms = latencyMs.load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    void reset() {
+        callbacks.store(0, std::memory_order_relaxed);
+        frames.store(0, std::memory_order_relaxed);
+        overflows.store(0, std::memory_order_relaxed);
+        underflows.store(0, std::memory_order_relaxed);
+        callbackTime.reset();
+    }
+};
+
+/**
+ * Records the lifetime of a scope into one or two histograms
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(HistogramCounters& primary, HistogramCounters* secondary = nullptr)
+        : primary_(primary), secondary_(secondary), start_(std::chrono::steady_clock::now()) {}
+    
+    ~ScopedTimer() {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        primary_.record(static_cast<uint64_t>(us));
+        if (secondary_) secondary_->record(static_cast<uint64_t>(us));
+    }
+    
+private:
+    HistogramCounters& primary_;
+    HistogramCounters* secondary_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * Everything between the backend and the application. The backend calls
+ * in through AudioIO from its device threads.
+ */
+struct AudioEngineImpl : public AudioIO {
+    std::unique_ptr<AudioBackend> backend;
     
     AudioCallback userCallback;
-    RingBuffer<float> playbackBuffer{PLAYBACK_BUFFER_SIZE};
+    PlaybackMixer mixer;
     
     std::atomic<bool> running{false};
     std::atomic<bool> initialized{false};
@@ -33,196 +194,610 @@ struct AudioEngineImpl {
     std::string lastError;
     
     AudioConfig config;
+    
+    // Threaded capture: the input callback only copies into captureRing,
+    // captureThread drains it and runs the user callback off the RT thread.
+    // Holds interleaved frames, so it is sized for the mic count.
+    std::unique_ptr<RingBuffer<float>> captureRing;
+    std::vector<float> captureScratch;  // One block, for reads that wrap the ring
+    std::thread captureThread;
+    std::atomic<bool> captureThreadRunning{false};
+    std::atomic<uint64_t> captureOverruns{0};
+    
+    // Every delivered capture block (after AEC), for stages on their own threads
+    std::unique_ptr<BroadcastRing<float>> captureBroadcast;
+    
+    void startCaptureThread();
+    void stopCaptureThread();
+    void captureWorker();
+    
+    // Full-duplex mode: one stream, both directions at config.sample_rate.
+    // duplexCallback has its own mutex, never callbackMutex: the capture
+    // worker holds that one through AEC3 and VAD, and the device thread
+    // must not wait behind it. The device thread only try_locks.
+    DuplexCallback duplexCallback;
+    std::mutex duplexMutex;
+    std::atomic<bool> duplexCallbackSet{false};
+    std::atomic<uint64_t> duplexSkipped{0};  // Blocks the callback missed (being replaced)
+    RateConverter playbackConverter;
+    uint64_t duplexFrames = 0;
+    
+    void deliverCapture(const float* samples, unsigned long frameCount);
+    void dispatchCapture(const float* samples, size_t count);
+    void publishCapture(const float* samples, size_t count);
+    
+    // Mic arrays: capture arrives interleaved with captureChannels per frame.
+    // Without AEC the engine beamforms it itself so consumers always get mono.
+    int captureChannels = 1;
+    std::unique_ptr<Beamformer> captureBeamformer;
+    std::vector<std::vector<float>> capturePlanes;  // One block per mic
+    std::vector<float*> capturePlanePtrs;
+    
+    const float* firstChannel(const float* samples, size_t count);
+    
+    // Render tap: the output path pushes exactly what it wrote to the device,
+    // the capture path feeds it to the attached AudioPipeline before AEC3
+    AudioPipeline* echoCanceller = nullptr;
+    EchoPathObserver echoObserver;  // Sees AEC3's inputs (delay calibration)
+    std::vector<float> aecOutput;  // One block plus the 10ms frame AEC3 may carry over
+    std::atomic<bool> renderTapEnabled{false};
+    RingBuffer<float> renderTap{RENDER_TAP_SIZE};
+    std::unique_ptr<Resampler> renderResampler;
+    std::vector<float> renderScratch; // Reference at the capture rate
+    int renderTapRate = 0;        // Rate of samples in renderTap
+    size_t renderHoldback = 0;    // Tap samples still inside the output device
+    
+    void configureRenderTap(double outputLatency);
+    void tapRender(const float* samples, size_t count);
+    size_t feedRenderReference();
+    
+    // Telemetry, cheap enough to poll from another thread at any rate
+    StreamCounters inputStats;
+    StreamCounters outputStats;
+    HistogramCounters processingTime;
+    
+    void recordStreamLatency(const BackendLatency& latency);
+    
+    // Real-time mode: thread promotion and locked, pre-faulted buffers
+    std::atomic<bool> rtInputPending{false};
+    std::atomic<bool> rtOutputPending{false};
+    std::atomic<bool> rtCaptureThread{false};
+    std::atomic<bool> rtInputCallback{false};
+    std::atomic<bool> rtOutputCallback{false};
+    std::vector<std::pair<const void*, size_t>> lockedRegions;
+    size_t lockedBytes = 0;
+    bool memoryLocked = false;
+    AudioPipeline* lockedPipeline = nullptr;  // Attached pipeline, locked by us
+    size_t pipelineLockedBytes = 0;
+    bool pipelineLocked = true;
+    std::mutex rtMutex;  // Guards rtError and the pipeline lock state
+    std::string rtError;
+    
+    void prepareRealtime();
+    void releaseRealtime();
+    void lockRegion(const void* addr, size_t bytes);
+    void lockPipeline(AudioPipeline* pipeline);
+    void promoteCallbackThread(std::atomic<bool>& pending, std::atomic<bool>& granted);
+    
+    // AudioIO, on the backend's device threads
+    void onCapture(const float* input, size_t frames, const BlockStatus& status) override;
+    void onRender(float* output, size_t frames, const BlockStatus& status) override;
+    void onDuplex(const float* input, float* output, size_t frames,
+                  const BlockTiming& timing, const BlockStatus& status) override;
+    bool playbackPending() const override;
 };
 
+struct AudioEngine::Impl : public AudioEngineImpl {};
+
+void AudioEngineImpl::startCaptureThread() {
+    if (captureThreadRunning) return;
+    captureRing->clear();
+    captureThreadRunning = true;
+    captureThread = std::thread([this]() { captureWorker(); });
+}
+
+void AudioEngineImpl::stopCaptureThread() {
+    if (!captureThreadRunning) return;
+    captureThreadRunning = false;
+    captureRing->wake();
+    if (captureThread.joinable()) {
+        captureThread.join();
+    }
+}
+
 /**
- * PortAudio callback for input stream
+ * Hand captured samples to the user, either directly or via the capture ring.
+ * Called from the real-time thread.
  */
-static int inputCallback(
-    const void* input,
-    void* output,
-    unsigned long frameCount,
-    const PaStreamCallbackTimeInfo* timeInfo,
-    PaStreamCallbackFlags statusFlags,
-    void* userData
-);
+void AudioEngineImpl::deliverCapture(const float* samples, unsigned long frameCount) {
+    if (!samples) return;
+    
+    // Threaded capture: copy into the SPSC ring and return, no locks taken
+    if (config.threaded_capture) {
+        const size_t count = frameCount * captureChannels;
+        size_t written = captureRing->push(samples, count);
+        if (written < count) {
+            captureOverruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    dispatchCapture(samples, frameCount);
+}
 
 /**
- * PortAudio callback for output stream
+ * Channel 0 of an interleaved block, for consumers that want one mic.
+ * count must not exceed frames_per_buffer, the size of capturePlanes.
  */
-static int outputCallback(
-    const void* input,
-    void* output,
-    unsigned long frameCount,
-    const PaStreamCallbackTimeInfo* timeInfo,
-    PaStreamCallbackFlags statusFlags,
-    void* userData
-);
+const float* AudioEngineImpl::firstChannel(const float* samples, size_t count) {
+    if (captureChannels == 1) return samples;
+    float* mono = capturePlanes[0].data();
+    for (size_t i = 0; i < count; ++i) {
+        mono[i] = samples[i * captureChannels];
+    }
+    return mono;
+}
 
-struct AudioEngine::Impl : public AudioEngineImpl {};
+/**
+ * Run echo cancellation (if attached) or beamforming, then the user callback.
+ * samples holds count frames of captureChannels interleaved samples.
+ * Caller holds callbackMutex.
+ */
+void AudioEngineImpl::dispatchCapture(const float* samples, size_t count) {
+    // Blocks larger than configured are split so the scratch never overflows
+    const size_t block = static_cast<size_t>(config.frames_per_buffer);
+    
+    if (echoCanceller) {
+        size_t referenceFrames = feedRenderReference();
+        
+        // The pipeline cancels echo per mic and beamforms to mono itself
+        for (size_t done = 0; done < count; done += block) {
+            const float* in = samples + done * captureChannels;
+            size_t n = std::min(block, count - done);
+            
+            // Per split block, so the mono copy never outgrows capturePlanes;
+            // the reference goes with the first one
+            if (echoObserver) {
+                echoObserver(renderScratch.data(), done == 0 ? referenceFrames : 0,
+                             firstChannel(in, n), n);
+            }
+            
+            size_t produced = echoCanceller->processCapture(in, n, aecOutput.data());
+            if (produced == 0) continue;
+            publishCapture(aecOutput.data(), produced);
+        }
+        return;
+    }
+    
+    if (captureBeamformer) {
+        for (size_t done = 0; done < count; done += block) {
+            size_t n = std::min(block, count - done);
+            deinterleave(samples + done * captureChannels, n, captureChannels, capturePlanePtrs.data());
+            captureBeamformer->process(capturePlanePtrs.data(), n, aecOutput.data());
+            publishCapture(aecOutput.data(), n);
+        }
+        return;
+    }
+    
+    publishCapture(samples, count);
+}
 
-AudioEngine::AudioEngine(const AudioConfig& config)
-    : pImpl_(std::make_unique<Impl>())
-    , config_(config)
-{
-    pImpl_->config = config;
+/**
+ * Hand one mono block to the broadcast ring and the user callback
+ */
+void AudioEngineImpl::publishCapture(const float* samples, size_t count) {
+    captureBroadcast->publish(samples, count);
+    
+    // Call user callback if set
+    if (userCallback) {
+        userCallback(samples, count);
+    }
 }
 
-AudioEngine::~AudioEngine() {
-    stop();
+/**
+ * Size the render tap for the stream that writes to the speaker. Samples stay
+ * in the tap for the device's reported output latency, so AEC3 receives each
+ * render block when it is actually played rather than when it is queued.
+ */
+void AudioEngineImpl::configureRenderTap(double outputLatency) {
+    renderTapRate = config.full_duplex ? config.sample_rate : config.output_sample_rate;
     
-    if (pImpl_->initialized) {
-        Pa_Terminate();
+    renderHoldback = std::min(
+        static_cast<size_t>(outputLatency * renderTapRate),
+        RENDER_TAP_SIZE / 2
+    );
+    
+    renderResampler = std::make_unique<Resampler>(renderTapRate, config.sample_rate);
+    renderScratch.assign(renderResampler->maxOutput(RENDER_TAP_SIZE), 0.0f);
+    renderTap.clear();
+}
+
+/**
+ * Called from the output path with the samples just written to the device.
+ */
+void AudioEngineImpl::tapRender(const float* samples, size_t count) {
+    if (renderTapEnabled.load(std::memory_order_acquire)) {
+        renderTap.push(samples, count);
     }
 }
 
-bool AudioEngine::initialize() {
-    if (pImpl_->initialized) {
-        return true;
+/**
+ * Move played render samples from the tap into AEC3 at the capture rate.
+ * Caller holds callbackMutex.
+ * @return Reference samples fed, left in renderScratch
+ */
+size_t AudioEngineImpl::feedRenderReference() {
+    size_t pending = renderTap.available();
+    if (pending <= renderHoldback) return 0;
+    
+    // Convert straight out of the tap's storage
+    auto ready = renderTap.peek_read(pending - renderHoldback);
+    size_t frames = renderResampler->process(
+        ready.first.data(), ready.first.size(), renderScratch.data());
+    frames += renderResampler->process(
+        ready.second.data(), ready.second.size(), renderScratch.data() + frames);
+    renderTap.consume(ready.size());
+    if (frames == 0) return 0;
+    
+    echoCanceller->feedRenderAudio(renderScratch.data(), frames);
+    return frames;
+}
+
+/**
+ * Store the latencies the backend actually granted for its open streams
+ */
+void AudioEngineImpl::recordStreamLatency(const BackendLatency& latency) {
+    if (latency.input > 0.0) {
+        inputStats.latencyMs.store(latency.input * 1000.0, std::memory_order_relaxed);
+    }
+    if (latency.output > 0.0) {
+        outputStats.latencyMs.store(latency.output * 1000.0, std::memory_order_relaxed);
+    }
+}
+
+void AudioEngineImpl::lockRegion(const void* addr, size_t bytes) {
+    if (!addr || bytes == 0) return;
+    if (lockMemory(addr, bytes)) {
+        lockedRegions.emplace_back(addr, bytes);
+        lockedBytes += bytes;
+    } else {
+        memoryLocked = false;
+    }
+}
+
+/**
+ * Lock engine-owned state and pre-fault the rings before any stream runs,
+ * so the real-time threads never take a page fault. Callback threads are
+ * flagged for promotion on their first invocation.
+ */
+void AudioEngineImpl::prepareRealtime() {
+    if (!config.realtime) return;
+    
+    releaseRealtime();
+    memoryLocked = true;
+    
+    lockRegion(this, sizeof(*this));
+    lockRegion(playbackConverter.scratch.data(), playbackConverter.scratch.size() * sizeof(float));
+    lockRegion(playbackConverter.pending.data(), playbackConverter.pending.size() * sizeof(float));
+    lockRegion(renderScratch.data(), renderScratch.size() * sizeof(float));
+    lockRegion(aecOutput.data(), aecOutput.size() * sizeof(float));
+    lockRegion(captureScratch.data(), captureScratch.size() * sizeof(float));
+    for (const std::vector<float>& plane : capturePlanes) {
+        lockRegion(plane.data(), plane.size() * sizeof(float));
+    }
+    if (captureBeamformer) {
+        captureBeamformer->visitBuffers([this](const void* data, size_t bytes) { lockRegion(data, bytes); });
     }
     
-    PaError err = Pa_Initialize();
-    if (err != paNoError) {
-        pImpl_->lastError = std::string("Pa_Initialize failed: ") + Pa_GetErrorText(err);
-        std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        return false;
+    // Streams are stopped, so an emptied ring exposes all of its storage
+    for (RingBuffer<float>* ring : {captureRing.get(), &renderTap}) {
+        ring->clear();
+        auto storage = ring->acquire_write(ring->capacity());
+        for (std::span<float> region : {storage.first, storage.second}) {
+            prefaultMemory(region.data(), region.size_bytes());
+            lockRegion(region.data(), region.size_bytes());
+        }
     }
     
-    pImpl_->initialized = true;
+    if (!memoryLocked) {
+        std::lock_guard<std::mutex> lock(rtMutex);
+        if (rtError.empty()) rtError = "mlock failed (check RLIMIT_MEMLOCK)";
+    }
+    
+    std::cout << "[AudioEngine] Real-time mode: " << (lockedBytes / 1024) << " KB locked"
+              << (memoryLocked ? "" : " (partial, mlock refused)") << std::endl;
     
-    // Log available devices
-    int numDevices = Pa_GetDeviceCount();
-    std::cout << "[AudioEngine] Found " << numDevices << " audio devices" << std::endl;
+    lockPipeline(echoCanceller);
     
-    int defaultInput = Pa_GetDefaultInputDevice();
-    int defaultOutput = Pa_GetDefaultOutputDevice();
+    rtInputCallback = false;
+    rtOutputCallback = false;
+    rtInputPending = true;
+    rtOutputPending = true;
+}
+
+void AudioEngineImpl::releaseRealtime() {
+    lockPipeline(nullptr);
+    for (const auto& [addr, bytes] : lockedRegions) {
+        unlockMemory(addr, bytes);
+    }
+    lockedRegions.clear();
+    lockedBytes = 0;
+    memoryLocked = false;
+    rtInputPending = false;
+    rtOutputPending = false;
+}
+
+/**
+ * Move the real-time lock and worker priority from the previously attached
+ * pipeline to this one (nullptr just releases). Runs outside callbackMutex:
+ * locking can take a while and the capture path must not wait on it.
+ */
+void AudioEngineImpl::lockPipeline(AudioPipeline* pipeline) {
+    if (pipeline == lockedPipeline) return;
     
-    if (defaultInput >= 0) {
-        const PaDeviceInfo* info = Pa_GetDeviceInfo(defaultInput);
-        std::cout << "[AudioEngine] Default input: " << info->name << std::endl;
+    if (lockedPipeline) {
+        lockedPipeline->setWorkerPriority(-1);
+        lockedPipeline->releaseRealtime();
     }
     
-    if (defaultOutput >= 0) {
-        const PaDeviceInfo* info = Pa_GetDeviceInfo(defaultOutput);
-        std::cout << "[AudioEngine] Default output: " << info->name << std::endl;
+    bool locked = true;
+    size_t bytes = 0;
+    if (pipeline) {
+        // The pipeline worker is fed by the capture thread, so it runs one
+        // below it; without a worker this has no effect
+        pipeline->setWorkerPriority(config.realtime_priority - 2, config.realtime_round_robin);
+        locked = pipeline->prepareRealtime();
+        bytes = pipeline->lockedBytes();
+        std::cout << "[AudioEngine] Real-time mode: " << (bytes / 1024) << " KB of AudioPipeline locked"
+                  << (locked ? "" : " (partial, mlock refused)") << std::endl;
     }
     
-    return true;
+    std::lock_guard<std::mutex> lock(rtMutex);
+    lockedPipeline = pipeline;
+    pipelineLockedBytes = bytes;
+    pipelineLocked = locked;
+    if (!locked && rtError.empty()) rtError = "mlock failed for AudioPipeline (check RLIMIT_MEMLOCK)";
 }
 
-bool AudioEngine::start() {
-    if (pImpl_->running) {
-        return true;
+/**
+ * Called at the top of a PortAudio callback; promotes its thread once.
+ */
+void AudioEngineImpl::promoteCallbackThread(std::atomic<bool>& pending, std::atomic<bool>& granted) {
+    if (!pending.load(std::memory_order_relaxed)) return;
+    pending.store(false, std::memory_order_relaxed);
+    granted.store(
+        promoteCurrentThread(config.realtime_priority, config.realtime_round_robin),
+        std::memory_order_relaxed);
+}
+
+/**
+ * Capture processing thread: hands the user callback the same block size the
+ * device delivers, so consumers see identical framing in both capture modes.
+ */
+void AudioEngineImpl::captureWorker() {
+    const size_t blockFrames = static_cast<size_t>(config.frames_per_buffer);
+    const size_t blockSize = blockFrames * captureChannels;
+    std::vector<float>& block = captureScratch;
+    
+    if (config.realtime) {
+        // One below the callbacks so the device threads always preempt us
+        std::string error;
+        rtCaptureThread = promoteCurrentThread(
+            config.realtime_priority - 1, config.realtime_round_robin, &error);
+        if (!rtCaptureThread) {
+            std::lock_guard<std::mutex> lock(rtMutex);
+            if (rtError.empty()) rtError = "capture thread: " + error;
+        }
     }
     
-    if (!pImpl_->initialized && !initialize()) {
-        return false;
+    // Block until the input callback commits a full block; the timeout only
+    // bounds how long a stalled device can hold the thread
+    const auto idleWait = std::chrono::milliseconds(100);
+    
+    while (captureThreadRunning) {
+        if (!captureRing->wait_for_data(blockSize, std::chrono::steady_clock::now() + idleWait)) {
+            continue;
+        }
+        auto ready = captureRing->peek_read(blockSize);
+        
+        // Dispatch in place unless the block wraps around the ring
+        const float* samples = ready.first.data();
+        if (!ready.second.empty()) {
+            std::copy(ready.first.begin(), ready.first.end(), block.begin());
+            std::copy(ready.second.begin(), ready.second.end(), block.begin() + ready.first.size());
+            samples = block.data();
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            ScopedTimer timer(processingTime);
+            dispatchCapture(samples, blockFrames);
+        }
+        captureRing->consume(blockSize);
     }
+}
+
+// ============================================================================
+// AudioIO (backend device threads)
+// ============================================================================
+
+void AudioEngineImpl::onCapture(const float* input, size_t frames, const BlockStatus& status) {
+    promoteCallbackThread(rtInputPending, rtInputCallback);
+    ScopedTimer timer(inputStats.callbackTime);
+    inputStats.onCallback(frames, status.input_overflow, status.input_underflow);
     
-    PaError err;
+    deliverCapture(input, frames);
+}
+
+void AudioEngineImpl::onRender(float* output, size_t frames, const BlockStatus& status) {
+    promoteCallbackThread(rtOutputPending, rtOutputCallback);
+    ScopedTimer timer(outputStats.callbackTime);
+    outputStats.onCallback(frames, status.output_overflow, status.output_underflow);
     
-    // Configure input stream
-    PaStreamParameters inputParams;
-    inputParams.device = (config_.input_device >= 0) 
-        ? config_.input_device 
-        : Pa_GetDefaultInputDevice();
+    // Mix all playback sources (zero-filled where nothing is queued)
+    mixer.mix(output, frames);
     
-    if (inputParams.device == paNoDevice) {
-        pImpl_->lastError = "No input device available";
-        std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        return false;
+    // Reference for echo cancellation is what the device plays, silence included
+    tapRender(output, frames);
+}
+
+void AudioEngineImpl::onDuplex(const float* input, float* output, size_t frames,
+                               const BlockTiming& deviceTiming, const BlockStatus& status) {
+    // One callback serves both directions
+    if (rtInputPending.load(std::memory_order_relaxed)) {
+        promoteCallbackThread(rtInputPending, rtInputCallback);
+        rtOutputPending = false;
+        rtOutputCallback = rtInputCallback.load();
     }
     
-    inputParams.channelCount = config_.channels;
-    inputParams.sampleFormat = paFloat32;
-    inputParams.suggestedLatency = Pa_GetDeviceInfo(inputParams.device)->defaultLowInputLatency;
-    inputParams.hostApiSpecificStreamInfo = nullptr;
-    
-    // Open input stream
-    err = Pa_OpenStream(
-        &pImpl_->inputStream,
-        &inputParams,
-        nullptr,  // No output for this stream
-        config_.sample_rate,
-        config_.frames_per_buffer,
-        paClipOff,
-        inputCallback,
-        pImpl_.get()
-    );
+    // ...so both directions record the same duration
+    ScopedTimer timer(inputStats.callbackTime, &outputStats.callbackTime);
+    inputStats.onCallback(frames, status.input_overflow, status.input_underflow);
+    outputStats.onCallback(frames, status.output_overflow, status.output_underflow);
+    
+    // Render first so the duplex callback sees exactly what the DAC gets
+    if (config.output_sample_rate == config.sample_rate) {
+        mixer.mix(output, frames);
+    } else {
+        playbackConverter.render(
+            [this](float* dst, size_t n) { mixer.mix(dst, n); return n; },
+            output, frames);
+    }
+    tapRender(output, frames);
+    
+    BlockTiming timing = deviceTiming;
+    timing.frame_index = duplexFrames;
+    duplexFrames += frames;
+    
+    deliverCapture(input, frames);
+    
+    // Only contends with setDuplexCallback(); a block that arrives while the
+    // callback is being replaced is counted and skipped rather than waited on
+    if (input && duplexCallbackSet.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(duplexMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            duplexSkipped.fetch_add(1, std::memory_order_relaxed);
+        } else if (duplexCallback) {
+            duplexCallback(input, output, frames, timing);
+        }
+    }
+}
+
+bool AudioEngineImpl::playbackPending() const {
+    return mixer.isActive();
+}
+
+// ============================================================================
+// AudioEngine
+// ============================================================================
+
+AudioEngine::AudioEngine(const AudioConfig& config)
+    : AudioEngine(config, std::make_unique<PortAudioBackend>())
+{
+}
+
+AudioEngine::AudioEngine(const AudioConfig& config, std::unique_ptr<AudioBackend> backend)
+    : pImpl_(std::make_unique<Impl>())
+    , config_(config)
+{
+    pImpl_->backend = std::move(backend);
+    pImpl_->config = config;
+    pImpl_->aecOutput.assign(config.frames_per_buffer + config.sample_rate / 100, 0.0f);
+    
+    const int mics = std::max(1, config.capture_channels);
+    pImpl_->captureChannels = mics;
+    
+    // Seconds at the configured rate, and never fewer than a few device blocks
+    const size_t captureFrames = std::max(
+        static_cast<size_t>(config.sample_rate) * CAPTURE_BUFFER_SECONDS,
+        static_cast<size_t>(config.frames_per_buffer) * CAPTURE_BUFFER_MIN_BLOCKS);
+    pImpl_->captureRing = std::make_unique<RingBuffer<float>>(captureFrames * mics);
+    pImpl_->captureBroadcast = std::make_unique<BroadcastRing<float>>(captureFrames);
+    pImpl_->captureScratch.assign(static_cast<size_t>(config.frames_per_buffer) * mics, 0.0f);
+    pImpl_->capturePlanes.assign(mics, std::vector<float>(config.frames_per_buffer, 0.0f));
+    for (std::vector<float>& plane : pImpl_->capturePlanes) {
+        pImpl_->capturePlanePtrs.push_back(plane.data());
+    }
+    if (mics > 1) {
+        int maxDelay = static_cast<int>(std::lround(
+            config.sample_rate * Beamformer::kDefaultMaxDelayMs / 1000.0f));
+        pImpl_->captureBeamformer = std::make_unique<Beamformer>(mics, std::max(1, maxDelay));
+        pImpl_->captureBeamformer->reserve(config.frames_per_buffer);
+    }
+}
+
+AudioEngine::~AudioEngine() {
+    stop();
+}
+
+bool AudioEngine::initialize() {
+    if (pImpl_->initialized) {
+        return true;
+    }
     
-    if (err != paNoError) {
-        pImpl_->lastError = std::string("Pa_OpenStream (input) failed: ") + Pa_GetErrorText(err);
+    if (!pImpl_->backend->initialize(pImpl_->lastError)) {
         std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
         return false;
     }
     
-    // Configure output stream
-    PaStreamParameters outputParams;
-    outputParams.device = (config_.output_device >= 0)
-        ? config_.output_device
-        : Pa_GetDefaultOutputDevice();
+    pImpl_->initialized = true;
+    return true;
+}
+
+bool AudioEngine::start() {
+    if (pImpl_->running) {
+        return true;
+    }
     
-    if (outputParams.device == paNoDevice) {
-        pImpl_->lastError = "No output device available";
-        std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        Pa_CloseStream(pImpl_->inputStream);
-        pImpl_->inputStream = nullptr;
+    if (!pImpl_->initialized && !initialize()) {
         return false;
     }
     
-    outputParams.channelCount = config_.channels;
-    outputParams.sampleFormat = paFloat32;
-    outputParams.suggestedLatency = Pa_GetDeviceInfo(outputParams.device)->defaultLowOutputLatency;
-    outputParams.hostApiSpecificStreamInfo = nullptr;
-    
-    // Open output stream
-    err = Pa_OpenStream(
-        &pImpl_->outputStream,
-        nullptr,  // No input for this stream
-        &outputParams,
-        config_.output_sample_rate,  // 24kHz for TTS output
-        config_.frames_per_buffer,
-        paClipOff,
-        outputCallback,
-        pImpl_.get()
-    );
+    // Full duplex: both directions run at the capture rate, playback is
+    // converted in the callback
+    if (config_.full_duplex) {
+        pImpl_->playbackConverter.configure(
+            config_.output_sample_rate, config_.sample_rate, config_.frames_per_buffer);
+        pImpl_->duplexFrames = 0;
+    }
     
-    if (err != paNoError) {
-        pImpl_->lastError = std::string("Pa_OpenStream (output) failed: ") + Pa_GetErrorText(err);
+    AudioBackend& backend = *pImpl_->backend;
+    if (!backend.open(config_, *pImpl_, pImpl_->lastError)) {
         std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        Pa_CloseStream(pImpl_->inputStream);
-        pImpl_->inputStream = nullptr;
         return false;
     }
     
-    // Start streams
-    err = Pa_StartStream(pImpl_->inputStream);
-    if (err != paNoError) {
-        pImpl_->lastError = std::string("Pa_StartStream (input) failed: ") + Pa_GetErrorText(err);
-        std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        Pa_CloseStream(pImpl_->inputStream);
-        Pa_CloseStream(pImpl_->outputStream);
-        pImpl_->inputStream = nullptr;
-        pImpl_->outputStream = nullptr;
-        return false;
+    BackendLatency latency = backend.latency();
+    pImpl_->configureRenderTap(latency.output);
+    pImpl_->recordStreamLatency(latency);
+    pImpl_->prepareRealtime();
+    
+    // Processing thread must be draining before the first input callback
+    if (config_.threaded_capture) {
+        pImpl_->startCaptureThread();
     }
     
-    err = Pa_StartStream(pImpl_->outputStream);
-    if (err != paNoError) {
-        pImpl_->lastError = std::string("Pa_StartStream (output) failed: ") + Pa_GetErrorText(err);
+    if (!backend.start(pImpl_->lastError)) {
         std::cerr << "[AudioEngine] " << pImpl_->lastError << std::endl;
-        Pa_StopStream(pImpl_->inputStream);
-        Pa_CloseStream(pImpl_->inputStream);
-        Pa_CloseStream(pImpl_->outputStream);
-        pImpl_->inputStream = nullptr;
-        pImpl_->outputStream = nullptr;
+        backend.close();
+        pImpl_->stopCaptureThread();
+        pImpl_->releaseRealtime();
         return false;
     }
     
     pImpl_->running = true;
-    std::cout << "[AudioEngine] Started (input=" << config_.sample_rate 
-              << "Hz, output=" << config_.output_sample_rate 
-              << "Hz, buffer=" << config_.frames_per_buffer << " frames)" << std::endl;
+    if (config_.full_duplex) {
+        std::cout << "[AudioEngine] Started full-duplex (rate=" << config_.sample_rate
+                  << "Hz, playback queued at " << config_.output_sample_rate
+                  << "Hz, buffer=" << config_.frames_per_buffer << " frames"
+                  << (config_.threaded_capture ? ", threaded capture" : "") << ")" << std::endl;
+    } else {
+        std::cout << "[AudioEngine] Started (input=" << config_.sample_rate 
+                  << "Hz, output=" << config_.output_sample_rate 
+                  << "Hz, buffer=" << config_.frames_per_buffer << " frames"
+                  << (config_.threaded_capture ? ", threaded capture" : "") << ")" << std::endl;
+    }
     
     return true;
 }
@@ -233,24 +808,21 @@ void AudioEngine::stop() {
     }
     
     pImpl_->running = false;
+    pImpl_->backend->close();
     
-    if (pImpl_->inputStream) {
-        Pa_StopStream(pImpl_->inputStream);
-        Pa_CloseStream(pImpl_->inputStream);
-        pImpl_->inputStream = nullptr;
-    }
+    // Streams are closed, so the ring has no producer left
+    pImpl_->stopCaptureThread();
+    pImpl_->releaseRealtime();
     
-    if (pImpl_->outputStream) {
-        Pa_StopStream(pImpl_->outputStream);
-        Pa_CloseStream(pImpl_->outputStream);
-        pImpl_->outputStream = nullptr;
+    if (pImpl_->captureOverruns > 0) {
+        std::cerr << "[AudioEngine] Capture ring overruns: " << pImpl_->captureOverruns << std::endl;
     }
     
     std::cout << "[AudioEngine] Stopped" << std::endl;
 }
 
 bool AudioEngine::isRunning() const {
-    return pImpl_->running;
+    return pImpl_->running && pImpl_->backend->isActive();
 }
 
 void AudioEngine::setInputCallback(AudioCallback callback) {
@@ -258,106 +830,147 @@ void AudioEngine::setInputCallback(AudioCallback callback) {
     pImpl_->userCallback = std::move(callback);
 }
 
+void AudioEngine::setDuplexCallback(DuplexCallback callback) {
+    std::lock_guard<std::mutex> lock(pImpl_->duplexMutex);
+    pImpl_->duplexCallback = std::move(callback);
+    pImpl_->duplexCallbackSet.store(static_cast<bool>(pImpl_->duplexCallback), std::memory_order_release);
+}
+
+void AudioEngine::setEchoCanceller(AudioPipeline* pipeline) {
+    if (pipeline && !pipeline->isInitialized()) {
+        pipeline = nullptr;
+    }
+    
+    // Lock the new pipeline before the capture path can reach it; start()
+    // takes care of this when the engine is not running yet
+    const bool realtime = config_.realtime && pImpl_->running;
+    if (realtime && pipeline) {
+        pImpl_->lockPipeline(pipeline);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(pImpl_->callbackMutex);
+        pImpl_->echoCanceller = pipeline;
+        pImpl_->renderTap.clear();
+        pImpl_->renderTapEnabled.store(pImpl_->echoCanceller != nullptr, std::memory_order_release);
+    }
+    
+    // Detached: nothing on the capture path touches the old pipeline any more
+    if (realtime && !pipeline) {
+        pImpl_->lockPipeline(nullptr);
+    }
+}
+
+void AudioEngine::setEchoPathObserver(EchoPathObserver observer) {
+    std::lock_guard<std::mutex> lock(pImpl_->callbackMutex);
+    pImpl_->echoObserver = std::move(observer);
+}
+
 void AudioEngine::queuePlayback(const float* samples, size_t count) {
-    pImpl_->playbackBuffer.push(samples, count);
+    if (count == 0) return;
+    queuePlayback(makeClip(std::vector<float>(samples, samples + count)));
+}
+
+bool AudioEngine::queuePlayback(AudioClip clip, int source) {
+    if (!pImpl_->mixer.enqueue(std::move(clip), source)) {
+        std::cerr << "[AudioEngine] Cannot queue playback on source " << source << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::setPlaybackGain(int source, float gain) {
+    pImpl_->mixer.setGain(source, gain);
 }
 
 void AudioEngine::clearPlayback() {
-    pImpl_->playbackBuffer.clear();
+    pImpl_->mixer.clear();
 }
 
 bool AudioEngine::isPlaying() const {
-    return pImpl_->playbackBuffer.available() > 0;
+    return pImpl_->mixer.isActive();
+}
+
+uint64_t AudioEngine::samplesPlayed() const {
+    return pImpl_->mixer.samplesPlayed();
+}
+
+bool AudioEngine::waitForPlaybackDrained(std::chrono::milliseconds timeout) {
+    // Missed wake-ups are bounded by one output buffer period
+    auto period = std::chrono::microseconds(
+        1000000LL * config_.frames_per_buffer / config_.output_sample_rate);
+    return pImpl_->mixer.waitForDrain(timeout, period);
+}
+
+BroadcastRing<float>& AudioEngine::captureBroadcast() {
+    return *pImpl_->captureBroadcast;
+}
+
+AudioStats AudioEngine::getStats() const {
+    AudioStats stats;
+    stats.input = pImpl_->inputStats.snapshot();
+    stats.output = pImpl_->outputStats.snapshot();
+    stats.processing_time = pImpl_->processingTime.snapshot();
+    stats.capture_ring_overruns = pImpl_->captureOverruns.load(std::memory_order_relaxed);
+    stats.duplex_blocks_skipped = pImpl_->duplexSkipped.load(std::memory_order_relaxed);
+    
+    stats.input.ring_occupancy = config_.threaded_capture ? pImpl_->captureRing->available() : 0;
+    stats.input.ring_capacity = config_.threaded_capture ? pImpl_->captureRing->capacity() : 0;
+    stats.output.ring_occupancy = pImpl_->mixer.queuedSamples();
+    stats.output.ring_capacity = 0;  // Mixer queues are unbounded in samples
+    
+    return stats;
+}
+
+RealtimeStatus AudioEngine::realtimeStatus() const {
+    RealtimeStatus status;
+    status.requested = config_.realtime;
+    status.capture_thread = pImpl_->rtCaptureThread;
+    status.input_callback = pImpl_->rtInputCallback;
+    status.output_callback = pImpl_->rtOutputCallback;
+    
+    std::lock_guard<std::mutex> lock(pImpl_->rtMutex);
+    status.memory_locked = pImpl_->memoryLocked && pImpl_->pipelineLocked;
+    status.locked_bytes = pImpl_->lockedBytes + pImpl_->pipelineLockedBytes;
+    status.pipeline_worker = pImpl_->lockedPipeline && pImpl_->lockedPipeline->isWorkerRealtime();
+    status.error = pImpl_->rtError;
+    return status;
+}
+
+void AudioEngine::resetStats() {
+    pImpl_->inputStats.reset();
+    pImpl_->outputStats.reset();
+    pImpl_->processingTime.reset();
+    pImpl_->captureOverruns.store(0, std::memory_order_relaxed);
+    pImpl_->duplexSkipped.store(0, std::memory_order_relaxed);
 }
 
 std::vector<std::string> AudioEngine::listInputDevices() {
-    std::vector<std::string> devices;
-    
-    PaError err = Pa_Initialize();
-    if (err != paNoError) {
-        return devices;
-    }
-    
-    int numDevices = Pa_GetDeviceCount();
-    for (int i = 0; i < numDevices; ++i) {
-        const PaDeviceInfo* info = Pa_GetDeviceInfo(i);
-        if (info && info->maxInputChannels > 0) {
-            devices.push_back(info->name);
-        }
-    }
-    
-    Pa_Terminate();
-    return devices;
+    return PortAudioBackend::listInputDevices();
 }
 
 std::vector<std::string> AudioEngine::listOutputDevices() {
-    std::vector<std::string> devices;
-    
-    PaError err = Pa_Initialize();
-    if (err != paNoError) {
-        return devices;
-    }
-    
-    int numDevices = Pa_GetDeviceCount();
-    for (int i = 0; i < numDevices; ++i) {
-        const PaDeviceInfo* info = Pa_GetDeviceInfo(i);
-        if (info && info->maxOutputChannels > 0) {
-            devices.push_back(info->name);
-        }
-    }
-    
-    Pa_Terminate();
-    return devices;
+    return PortAudioBackend::listOutputDevices();
 }
 
-std::string AudioEngine::lastError() const {
-    return pImpl_->lastError;
+const AudioConfig& AudioEngine::config() const {
+    return config_;
 }
 
-// ============================================================================
-// PortAudio Callbacks
-// ============================================================================
+std::string AudioEngine::inputDeviceName() const {
+    return pImpl_->backend->deviceName(config_, true);
+}
 
-static int inputCallback(
-    const void* input,
-    void* output,
-    unsigned long frameCount,
-    const PaStreamCallbackTimeInfo* timeInfo,
-    PaStreamCallbackFlags statusFlags,
-    void* userData
-) {
-    auto* impl = static_cast<AudioEngineImpl*>(userData);
-    const float* samples = static_cast<const float*>(input);
-    
-    // Call user callback if set
-    std::lock_guard<std::mutex> lock(impl->callbackMutex);
-    if (impl->userCallback && samples) {
-        impl->userCallback(samples, frameCount);
-    }
-    
-    return paContinue;
+std::string AudioEngine::outputDeviceName() const {
+    return pImpl_->backend->deviceName(config_, false);
 }
 
-static int outputCallback(
-    const void* input,
-    void* output,
-    unsigned long frameCount,
-    const PaStreamCallbackTimeInfo* timeInfo,
-    PaStreamCallbackFlags statusFlags,
-    void* userData
-) {
-    auto* impl = static_cast<AudioEngineImpl*>(userData);
-    float* out = static_cast<float*>(output);
-    
-    // Read from playback buffer
-    size_t read = impl->playbackBuffer.pop(out, frameCount);
-    
-    // Zero-fill if not enough data
-    if (read < frameCount) {
-        std::memset(out + read, 0, (frameCount - read) * sizeof(float));
-    }
-    
-    return paContinue;
+std::string AudioEngine::lastError() const {
+    return pImpl_->lastError;
+}
+
+AudioBackend& AudioEngine::backend() const {
+    return *pImpl_->backend;
 }
 
 } // namespace rtv::audio
@@ -1,50 +1,593 @@
 /**
- * AudioPipeline.cpp - WebRTC AEC3 integration for echo cancellation
+ * AudioPipeline.cpp - WebRTC capture processing (HPF -> AEC3 -> BF -> NS -> AGC)
  * 
- * Enables barge-in by removing speaker echo from microphone input.
+ * Enables barge-in by removing speaker echo from microphone input, and
+ * cleans the capture up for VAD and STT. Mic arrays are echo-cancelled
+ * per channel, then beamformed to one stream.
  */
 
 #include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/Beamformer.hpp"
+#include "rtv/audio/Deinterleave.hpp"
+#include "rtv/audio/FrameAssembler.hpp"
+#include "rtv/audio/PipelineTypes.hpp"
+#include "rtv/audio/Realtime.hpp"
+#include "rtv/audio/RingBuffer.hpp"
 
 #include "audio_processing/aec3/echo_canceller3.h"
 #include "audio_processing/audio_buffer.h"
 
+// Optional stages, present in the fetched AEC3 tree but not in every extraction
+#if __has_include("audio_processing/high_pass_filter.h")
+#include "audio_processing/high_pass_filter.h"
+#define RTV_HAS_WEBRTC_HPF 1
+#endif
+#if __has_include("audio_processing/ns/noise_suppressor.h")
+#include "audio_processing/ns/noise_suppressor.h"
+#define RTV_HAS_WEBRTC_NS 1
+#endif
+
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace rtv::audio {
 
 // AEC3 processes in 10ms frames
 constexpr int FRAME_MS = 10;
 
+// Metrics defaults: refresh every 100ms, flag echo when half the capture
+// energy is being removed
+constexpr int DEFAULT_METRICS_INTERVAL = 10;
+constexpr float DEFAULT_ECHO_THRESHOLD = 0.5f;
+
+// Render frames below -60 dBFS (mean square) count as silence
+constexpr float RENDER_ACTIVE_FLOOR = 1e-6f;
+
+// Worker mode: queue depth of each hand-off ring, in 10ms frames
+constexpr size_t WORKER_QUEUE_FRAMES = 50;
+
+// AGC: frames quieter than this are noise and never raise the gain
+constexpr float AGC_GATE_DBFS = -50.0f;
+constexpr float AGC_RISE_DB_PER_FRAME = 0.05f;  // 5 dB/s
+constexpr float AGC_FALL_DB_PER_FRAME = 1.0f;   // 100 dB/s
+constexpr float AGC_PEAK_LIMIT = 0.9f;
+
+namespace {
+
+float meanSquare(const float* samples, int count) {
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i) sum += samples[i] * samples[i];
+    return count > 0 ? sum / count : 0.0f;
+}
+
+/**
+ * Single-writer seqlock holding a trivially copyable value. The value is
+ * stored as relaxed atomic words so a reader racing the writer is
+ * well-defined; the sequence number tells it to retry.
+ */
+template <typename T>
+class SeqlockSlot {
+    static_assert(std::is_trivially_copyable_v<T>);
+    
+public:
+    void store(const T& value) {
+        std::array<uint64_t, kWords> raw{};
+        std::memcpy(raw.data(), &value, sizeof(T));
+        
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            words_[i].store(raw[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+    
+    T load() const {
+        std::array<uint64_t, kWords> raw{};
+        uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < kWords; ++i) {
+                raw[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        
+        T value;
+        std::memcpy(static_cast<void*>(&value), raw.data(), sizeof(T));
+        return value;
+    }
+    
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    std::atomic<uint32_t> seq_{0};
+    std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+/**
+ * Adaptive digital gain: steers the frame level towards a target, rising
+ * slowly through speech and falling fast, and never lets a peak clip.
+ * Gain changes are ramped across the frame so there is no zipper noise.
+ */
+class DigitalAgc {
+public:
+    void configure(float target_dbfs, float max_gain_db) {
+        target_db_ = target_dbfs;
+        max_gain_db_ = std::max(0.0f, max_gain_db);
+    }
+    
+    void reset() { gain_db_ = 0.0f; }
+    
+    void process(float* const* channels, size_t num_channels, size_t frames) {
+        float energy = 0.0f;
+        float peak = 0.0f;
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            for (size_t i = 0; i < frames; ++i) {
+                float s = channels[ch][i];
+                energy += s * s;
+                peak = std::max(peak, std::abs(s));
+            }
+        }
+        float level_db = 10.0f * std::log10(energy / (num_channels * frames) + 1e-12f);
+        
+        float desired = std::clamp(target_db_ - level_db, 0.0f, max_gain_db_);
+        if (level_db < AGC_GATE_DBFS) {
+            desired = std::min(desired, gain_db_);  // Hold through silence
+        }
+        if (peak > 0.0f) {
+            desired = std::min(desired, 20.0f * std::log10(AGC_PEAK_LIMIT / peak));
+        }
+        
+        float next = desired > gain_db_
+            ? std::min(desired, gain_db_ + AGC_RISE_DB_PER_FRAME)
+            : std::max(desired, gain_db_ - AGC_FALL_DB_PER_FRAME);
+        
+        const float g0 = std::pow(10.0f, gain_db_ / 20.0f);
+        const float g1 = std::pow(10.0f, next / 20.0f);
+        const float step = (g1 - g0) / frames;
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            float g = g0;
+            for (size_t i = 0; i < frames; ++i, g += step) {
+                channels[ch][i] = std::clamp(channels[ch][i] * g, -1.0f, 1.0f);
+            }
+        }
+        gain_db_ = next;
+    }
+    
+private:
+    float target_db_ = -20.0f;
+    float max_gain_db_ = 18.0f;
+    float gain_db_ = 0.0f;
+};
+
+/**
+ * Per-stage time counters, written on the capture thread and read by
+ * getStats() with relaxed loads
+ */
+struct StageCounters {
+    std::atomic<bool> enabled{false};
+    bool available = false;
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    
+    void record(uint64_t ns) {
+        frames.fetch_add(1, std::memory_order_relaxed);
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+    
+    StageStats snapshot() const {
+        StageStats s;
+        s.available = available;
+        s.enabled = enabled.load(std::memory_order_relaxed);
+        s.frames = frames.load(std::memory_order_relaxed);
+        s.total_ns = total_ns.load(std::memory_order_relaxed);
+        s.max_ns = max_ns.load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    void reset() {
+        frames.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+};
+
+#ifdef RTV_HAS_WEBRTC_NS
+webrtc::NsConfig::SuppressionLevel toWebrtc(NoiseSuppressionLevel level) {
+    switch (level) {
+        case NoiseSuppressionLevel::Low:      return webrtc::NsConfig::SuppressionLevel::k6dB;
+        case NoiseSuppressionLevel::Moderate: return webrtc::NsConfig::SuppressionLevel::k12dB;
+        case NoiseSuppressionLevel::High:     return webrtc::NsConfig::SuppressionLevel::k18dB;
+        case NoiseSuppressionLevel::VeryHigh: return webrtc::NsConfig::SuppressionLevel::k21dB;
+    }
+    return webrtc::NsConfig::SuppressionLevel::k12dB;
+}
+#endif
+
+} // namespace
+
 struct AudioPipeline::Impl {
     std::unique_ptr<webrtc::EchoCanceller3> aec3;
     std::unique_ptr<webrtc::AudioBuffer> render_buffer;
-    std::unique_ptr<webrtc::AudioBuffer> capture_buffer;
+    std::unique_ptr<webrtc::AudioBuffer> capture_buffer;  // Shared by every capture stage
+#ifdef RTV_HAS_WEBRTC_HPF
+    std::unique_ptr<webrtc::HighPassFilter> high_pass;
+#endif
+#ifdef RTV_HAS_WEBRTC_NS
+    std::unique_ptr<webrtc::NoiseSuppressor> noise_suppressor;
+#endif
+    std::unique_ptr<Beamformer> beamformer;  // Mic arrays only
+    DigitalAgc agc;
+    
+    PipelineConfig config;
+    std::array<StageCounters, kPipelineStages> stages;
+    std::atomic<uint64_t> frames_processed{0};
     
     int sample_rate;
-    int num_channels;
-    int samples_per_frame;  // Samples per 10ms frame
+    int num_channels;       // Capture channels (mics); render is always mono
+    int samples_per_frame;  // Samples per 10ms frame, per channel
+    
+    // Block-to-10ms-frame adapters (sized in the constructor, never grow).
+    // Capture frames stay interleaved until processFrame splits them.
+    FrameAssembler render_frames{0};
+    FrameAssembler capture_frames{0};
+    
+    // Metrics, refreshed on the capture thread every metrics_interval frames
+    std::atomic<int> metrics_interval{DEFAULT_METRICS_INTERVAL};
+    std::atomic<float> echo_threshold{DEFAULT_ECHO_THRESHOLD};
+    std::atomic<uint32_t> render_active_frames{0};  // Counted on the render side
+    int frames_since_update = 0;
+    uint64_t frames_total = 0;
+    uint64_t updates = 0;
+    double capture_energy = 0.0;   // Interval totals (lowest band) around AEC3
+    double residual_energy = 0.0;
+    SeqlockSlot<AecMetrics> metrics;
+    
+    // Delay hint set from any thread, handed to AEC3 on the capture thread
+    std::atomic<int> pending_delay_ms{-1};
+    std::atomic<int> delay_hint_ms{-1};
     
-    // Frame accumulation buffers
-    std::vector<float> render_accumulator;
-    std::vector<float> capture_accumulator;
+    // Worker mode (PipelineConfig::worker_thread): callers only frame and
+    // enqueue, the worker runs every stage. Each ring is SPSC.
+    std::unique_ptr<RingBuffer<float>> capture_ring;     // Whole interleaved frames
+    std::unique_ptr<RingBuffer<int64_t>> capture_stamps; // Enqueue time per frame (steady ns)
+    std::unique_ptr<RingBuffer<float>> render_ring;      // Raw render samples
+    std::unique_ptr<RingBuffer<float>> output_ring;      // Processed mono frames
+    std::vector<float> worker_frame;
+    std::vector<float> worker_out;
+    std::vector<float> render_scratch;
+    std::thread worker;
+    std::atomic<bool> worker_running{false};
+    int64_t deadline_ns = 0;
+    std::atomic<uint64_t> frames_late{0};
+    std::atomic<uint64_t> frames_dropped{0};
+    
+    // Worker scheduling from setWorkerPriority(), applied by the worker
+    // itself (and again by every worker reset() starts)
+    std::atomic<int> worker_priority{-1};  // Below 0: SCHED_OTHER
+    std::atomic<bool> worker_round_robin{false};
+    std::atomic<bool> worker_sched_pending{false};
+    std::atomic<bool> worker_realtime{false};
+    
+    // Real-time mode: regions locked by prepareRealtime()
+    std::vector<std::pair<const void*, size_t>> locked_regions;
+    size_t locked_bytes = 0;
     
-    // Metrics
-    float erle = 0.0f;
-    bool echo_detected = false;
     bool initialized = false;
+    
+    ~Impl() {
+        stopWorker();
+        unlockRegions();
+    }
+    
+    StageCounters& stage(PipelineStage s) {
+        return stages[static_cast<size_t>(s)];
+    }
+    
+    /**
+     * Run fn as stage s if it is enabled, timing it
+     */
+    template <typename Fn>
+    void runStage(PipelineStage s, Fn&& fn) {
+        StageCounters& counters = stage(s);
+        if (!counters.enabled.load(std::memory_order_relaxed)) return;
+        
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        counters.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+    
+    /**
+     * Lowest band of channel 0: the full band at 16kHz, the 0-8kHz band
+     * once a 32/48kHz buffer has been split
+     */
+    float bandEnergy() {
+        return meanSquare(capture_buffer->split_bands_f(0)[0],
+                          static_cast<int>(capture_buffer->num_frames_per_band()));
+    }
+    
+    /**
+     * One interleaved 10ms frame through HPF -> AEC3 (every mic) -> BF ->
+     * NS -> AGC (mono), in place on capture_buffer
+     */
+    void processFrame(const float* frame, float* out) {
+        webrtc::AudioBuffer* buffer = capture_buffer.get();
+        buffer->set_num_channels(num_channels);
+        deinterleave(frame, samples_per_frame, num_channels, buffer->channels_f());
+        
+        // AEC3 analyses the full band before anything modifies it
+        const bool aec_on = stage(PipelineStage::EchoCancel).enabled.load(std::memory_order_relaxed);
+        if (aec_on) {
+            aec3->AnalyzeCapture(buffer);
+        }
+        
+        const bool split = buffer->num_bands() > 1;
+        if (split) buffer->SplitIntoFrequencyBands();
+        
+#ifdef RTV_HAS_WEBRTC_HPF
+        runStage(PipelineStage::HighPass, [&]() { high_pass->Process(buffer, true); });
+#endif
+        
+        float before = aec_on ? bandEnergy() : 0.0f;
+        runStage(PipelineStage::EchoCancel, [&]() { aec3->ProcessCapture(buffer, false); });
+        if (aec_on) {
+            capture_energy += before;
+            residual_energy += bandEnergy();
+        }
+        
+        // The beam is formed on the full band; mono from here on (mic 0
+        // alone when beamforming is off)
+        if (num_channels > 1) {
+            if (split) buffer->MergeFrequencyBands();
+            runStage(PipelineStage::Beamform, [&]() {
+                beamformer->process(buffer->channels_f(), samples_per_frame, buffer->channels_f()[0]);
+            });
+            buffer->set_num_channels(1);
+            if (split) buffer->SplitIntoFrequencyBands();
+        }
+        
+#ifdef RTV_HAS_WEBRTC_NS
+        runStage(PipelineStage::NoiseSuppress, [&]() {
+            noise_suppressor->Analyze(*buffer);
+            noise_suppressor->Process(buffer);
+        });
+#endif
+        
+        if (split) buffer->MergeFrequencyBands();
+        
+        runStage(PipelineStage::GainControl, [&]() {
+            agc.process(buffer->channels_f(), 1, samples_per_frame);
+        });
+        
+        std::copy_n(buffer->channels_const_f()[0], samples_per_frame, out);
+        frames_processed.fetch_add(1, std::memory_order_relaxed);
+        
+        ++frames_total;
+        if (++frames_since_update >= metrics_interval.load(std::memory_order_relaxed)) {
+            refreshMetrics();
+        }
+    }
+    
+    void applyPendingDelay() {
+        int delay_ms = pending_delay_ms.exchange(-1, std::memory_order_acquire);
+        if (delay_ms >= 0) {
+            aec3->SetAudioBufferDelay(delay_ms);
+        }
+    }
+    
+    void analyzeRender(const float* frame) {
+        std::copy_n(frame, samples_per_frame, render_buffer->channels_f()[0]);
+        
+        // Band-split above 16kHz like the capture
+        if (render_buffer->num_bands() > 1) {
+            render_buffer->SplitIntoFrequencyBands();
+        }
+        aec3->AnalyzeRender(render_buffer.get());
+        
+        if (meanSquare(frame, samples_per_frame) > RENDER_ACTIVE_FLOOR) {
+            render_active_frames.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    void startWorker(float deadline_ms) {
+        const size_t frame_samples = static_cast<size_t>(samples_per_frame) * num_channels;
+        capture_ring = std::make_unique<RingBuffer<float>>(frame_samples * WORKER_QUEUE_FRAMES);
+        capture_stamps = std::make_unique<RingBuffer<int64_t>>(WORKER_QUEUE_FRAMES);
+        render_ring = std::make_unique<RingBuffer<float>>(samples_per_frame * WORKER_QUEUE_FRAMES);
+        output_ring = std::make_unique<RingBuffer<float>>(samples_per_frame * WORKER_QUEUE_FRAMES);
+        worker_frame.assign(frame_samples, 0.0f);
+        worker_out.assign(samples_per_frame, 0.0f);
+        render_scratch.assign(samples_per_frame * WORKER_QUEUE_FRAMES, 0.0f);
+        deadline_ns = static_cast<int64_t>(std::max(0.0f, deadline_ms) * 1e6f);
+        
+        worker_running = true;
+        worker = std::thread([this]() { workerLoop(); });
+    }
+    
+    void stopWorker() {
+        if (!worker_running) return;
+        worker_running = false;
+        capture_stamps->wake();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    
+    /**
+     * Caller side of worker mode: hand one frame over, or drop it when
+     * the worker is a full queue behind
+     */
+    void enqueueFrame(const float* frame) {
+        const size_t frame_samples = worker_frame.size();
+        if (capture_ring->space() < frame_samples || capture_stamps->space() < 1) {
+            frames_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        capture_ring->push(frame, frame_samples);
+        
+        // Stamp last: the worker waits on stamps, so the samples are there
+        const int64_t stamp = nowNs();
+        capture_stamps->push(&stamp, 1);
+    }
+    
+    void applyWorkerPriority() {
+        const int priority = worker_priority.load(std::memory_order_acquire);
+        if (priority < 0) {
+            if (worker_realtime) demoteCurrentThread();
+            worker_realtime = false;
+            return;
+        }
+        
+        std::string error;
+        worker_realtime = promoteCurrentThread(
+            priority, worker_round_robin.load(std::memory_order_relaxed), &error);
+        if (!worker_realtime) {
+            std::cerr << "[AudioPipeline] Worker stays SCHED_OTHER: " << error << std::endl;
+        }
+    }
+    
+    void workerLoop() {
+        const size_t frame_samples = worker_frame.size();
+        const auto idleWait = std::chrono::milliseconds(100);
+        
+        // A restarted worker (reset()) takes over the scheduling of the last one
+        worker_sched_pending = false;
+        if (worker_priority.load(std::memory_order_acquire) >= 0) {
+            applyWorkerPriority();
+        }
+        
+        while (worker_running) {
+            if (worker_sched_pending.exchange(false, std::memory_order_acq_rel)) {
+                applyWorkerPriority();
+            }
+            if (!capture_stamps->wait_for_data(1, std::chrono::steady_clock::now() + idleWait)) {
+                continue;
+            }
+            
+            // Render that arrived before this capture frame goes first
+            size_t render_count = render_ring->pop(render_scratch.data(), render_scratch.size());
+            render_frames.push(render_scratch.data(), render_count,
+                               [this](const float* frame) { analyzeRender(frame); });
+            applyPendingDelay();
+            
+            int64_t stamp = 0;
+            capture_stamps->pop(&stamp, 1);
+            capture_ring->pop(worker_frame.data(), frame_samples);
+            
+            // Past its deadline: pass the first mic through to catch up
+            if (nowNs() - stamp > deadline_ns) {
+                for (int i = 0; i < samples_per_frame; ++i) {
+                    worker_out[i] = worker_frame[static_cast<size_t>(i) * num_channels];
+                }
+                frames_late.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                processFrame(worker_frame.data(), worker_out.data());
+            }
+            
+            if (output_ring->space() < worker_out.size()) {
+                frames_dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            output_ring->push(worker_out.data(), worker_out.size());
+        }
+    }
+    
+    bool lockRegion(const void* addr, size_t bytes) {
+        if (!addr || bytes == 0) return true;
+        if (!lockMemory(addr, bytes)) return false;
+        locked_regions.emplace_back(addr, bytes);
+        locked_bytes += bytes;
+        return true;
+    }
+    
+    template <typename T>
+    bool lockVector(const std::vector<T>& v) {
+        return lockRegion(v.data(), v.size() * sizeof(T));
+    }
+    
+    /**
+     * Channel data and band-split storage of a WebRTC buffer
+     */
+    bool lockAudioBuffer(webrtc::AudioBuffer* buffer, int channels) {
+        bool ok = true;
+        for (int c = 0; c < channels; ++c) {
+            ok &= lockRegion(buffer->channels_f()[c], buffer->num_frames() * sizeof(float));
+            if (buffer->num_bands() > 1) {
+                float* const* bands = buffer->split_bands_f(c);
+                for (size_t b = 0; b < buffer->num_bands(); ++b) {
+                    ok &= lockRegion(bands[b], buffer->num_frames_per_band() * sizeof(float));
+                }
+            }
+        }
+        return ok;
+    }
+    
+    void unlockRegions() {
+        for (const auto& [addr, bytes] : locked_regions) {
+            unlockMemory(addr, bytes);
+        }
+        locked_regions.clear();
+        locked_bytes = 0;
+    }
+    
+    void refreshMetrics() {
+        const webrtc::EchoCanceller3::Metrics aec = aec3->GetMetrics();
+        
+        AecMetrics m;
+        m.erle_db = aec.echo_return_loss_enhancement;
+        m.erl_db = aec.echo_return_loss;
+        m.delay_ms = aec.delay_ms;
+        m.render_active = render_active_frames.exchange(0, std::memory_order_relaxed) > 0;
+        if (m.render_active && capture_energy > 0.0) {
+            double removed = 1.0 - residual_energy / capture_energy;
+            m.echo_likelihood = static_cast<float>(std::clamp(removed, 0.0, 1.0));
+        }
+        m.echo_detected = m.render_active &&
+            m.echo_likelihood >= echo_threshold.load(std::memory_order_relaxed);
+        m.frames = frames_total;
+        m.updates = ++updates;
+        metrics.store(m);
+        
+        frames_since_update = 0;
+        capture_energy = 0.0;
+        residual_energy = 0.0;
+    }
 };
 
-AudioPipeline::AudioPipeline(int sample_rate, int num_channels)
+AudioPipeline::AudioPipeline(int sample_rate, int num_channels, const PipelineConfig& config)
     : pImpl_(std::make_unique<Impl>())
     , sample_rate_(sample_rate)
     , num_channels_(num_channels)
 {
+    pImpl_->config = config;
     pImpl_->sample_rate = sample_rate;
     pImpl_->num_channels = num_channels;
     pImpl_->samples_per_frame = (sample_rate * FRAME_MS) / 1000;
+    pImpl_->render_frames = FrameAssembler(pImpl_->samples_per_frame);
+    pImpl_->capture_frames = FrameAssembler(pImpl_->samples_per_frame * num_channels);
     
     // Validate sample rate
     if (sample_rate != 16000 && sample_rate != 32000 && sample_rate != 48000) {
@@ -54,25 +597,26 @@ AudioPipeline::AudioPipeline(int sample_rate, int num_channels)
     }
     
     // Create AEC3 config
-    webrtc::EchoCanceller3Config config;
+    webrtc::EchoCanceller3Config aec_config;
     
     try {
-        // Create echo canceller
+        // Create echo canceller: one loudspeaker reference, echo removed
+        // from every mic
         pImpl_->aec3 = std::make_unique<webrtc::EchoCanceller3>(
-            config,
+            aec_config,
             sample_rate,
-            num_channels,  // render channels
+            1,             // render channels
             num_channels   // capture channels
         );
         
         // Create audio buffers
         pImpl_->render_buffer = std::make_unique<webrtc::AudioBuffer>(
             sample_rate,
-            num_channels,
+            1,
             sample_rate,
-            num_channels,
+            1,
             sample_rate,
-            num_channels
+            1
         );
         
         pImpl_->capture_buffer = std::make_unique<webrtc::AudioBuffer>(
@@ -84,10 +628,56 @@ AudioPipeline::AudioPipeline(int sample_rate, int num_channels)
             num_channels
         );
         
+        pImpl_->stage(PipelineStage::EchoCancel).available = true;
+        
+#ifdef RTV_HAS_WEBRTC_HPF
+        pImpl_->high_pass = std::make_unique<webrtc::HighPassFilter>(sample_rate, num_channels);
+        pImpl_->stage(PipelineStage::HighPass).available = true;
+#endif
+        
+#ifdef RTV_HAS_WEBRTC_NS
+        webrtc::NsConfig ns_config;
+        ns_config.target_level = toWebrtc(config.ns_level);
+        pImpl_->noise_suppressor = std::make_unique<webrtc::NoiseSuppressor>(
+            ns_config, sample_rate, 1);  // Runs after the beamformer
+        pImpl_->stage(PipelineStage::NoiseSuppress).available = true;
+#endif
+        
+        if (num_channels > 1) {
+            int max_delay = static_cast<int>(std::lround(sample_rate * config.beamformer_max_delay_ms / 1000.0f));
+            pImpl_->beamformer = std::make_unique<Beamformer>(num_channels, std::max(1, max_delay));
+            pImpl_->stage(PipelineStage::Beamform).available = true;
+        }
+        
+        pImpl_->agc.configure(config.agc_target_dbfs, config.agc_max_gain_db);
+        pImpl_->stage(PipelineStage::GainControl).available = true;
+        
+        setStageEnabled(PipelineStage::HighPass, config.high_pass);
+        setStageEnabled(PipelineStage::EchoCancel, config.echo_cancellation);
+        if (num_channels > 1) setStageEnabled(PipelineStage::Beamform, config.beamforming);
+        setStageEnabled(PipelineStage::NoiseSuppress, config.noise_suppression);
+        setStageEnabled(PipelineStage::GainControl, config.gain_control);
+        
         pImpl_->initialized = true;
         
+        if (config.worker_thread) {
+            pImpl_->startWorker(config.worker_deadline_ms);
+        }
+        
         std::cout << "[AudioPipeline] AEC3 initialized (sample_rate=" << sample_rate 
-                  << "Hz, frame=" << pImpl_->samples_per_frame << " samples)" << std::endl;
+                  << "Hz, frame=" << pImpl_->samples_per_frame << " samples, mics=" << num_channels
+                  << ", chain=";
+        bool first = true;
+        for (size_t i = 0; i < kPipelineStages; ++i) {
+            if (!pImpl_->stages[i].enabled) continue;
+            std::cout << (first ? "" : " -> ") << stageName(static_cast<PipelineStage>(i));
+            first = false;
+        }
+        std::cout << ")";
+        if (config.worker_thread) {
+            std::cout << " on a worker thread (deadline " << config.worker_deadline_ms << "ms)";
+        }
+        std::cout << std::endl;
                   
     } catch (const std::exception& e) {
         std::cerr << "[AudioPipeline] AEC3 initialization failed: " << e.what() << std::endl;
@@ -103,85 +693,218 @@ bool AudioPipeline::isInitialized() const {
 void AudioPipeline::feedRenderAudio(const float* samples, size_t count) {
     if (!pImpl_->initialized) return;
     
-    // Accumulate samples
-    for (size_t i = 0; i < count; ++i) {
-        pImpl_->render_accumulator.push_back(samples[i]);
+    Impl& impl = *pImpl_;
+    if (impl.worker_running) {
+        // A full ring means the worker stalled; AEC3 re-aligns after the gap
+        impl.render_ring->push(samples, count);
+        return;
     }
     
-    // Process complete frames
-    while (pImpl_->render_accumulator.size() >= static_cast<size_t>(pImpl_->samples_per_frame)) {
-        // Copy to audio buffer
-        float* const* buffer_data = pImpl_->render_buffer->channels_f();
-        for (int i = 0; i < pImpl_->samples_per_frame; ++i) {
-            buffer_data[0][i] = pImpl_->render_accumulator[i];
-        }
-        
-        // Analyze render (reference) signal
-        pImpl_->aec3->AnalyzeRender(pImpl_->render_buffer.get());
-        
-        // Remove processed samples
-        pImpl_->render_accumulator.erase(
-            pImpl_->render_accumulator.begin(),
-            pImpl_->render_accumulator.begin() + pImpl_->samples_per_frame
-        );
-    }
+    impl.render_frames.push(samples, count, [&impl](const float* frame) {
+        impl.analyzeRender(frame);
+    });
 }
 
-std::vector<float> AudioPipeline::processCapture(const float* samples, size_t count) {
+size_t AudioPipeline::processCapture(const float* samples, size_t count, float* out) {
     if (!pImpl_->initialized) {
-        // Return input unchanged if not initialized
-        return std::vector<float>(samples, samples + count);
+        // Pass the first mic through unchanged if not initialized
+        const int channels = std::max(1, num_channels_);
+        for (size_t i = 0; i < count; ++i) out[i] = samples[i * channels];
+        return count;
+    }
+    
+    Impl& impl = *pImpl_;
+    if (impl.worker_running) {
+        // Framing is only a copy; everything else happens on the worker
+        impl.capture_frames.push(samples, count * impl.num_channels, [&impl](const float* frame) {
+            impl.enqueueFrame(frame);
+        });
+        return impl.output_ring->pop(out, count + impl.samples_per_frame);
     }
     
-    std::vector<float> output;
-    output.reserve(count);
+    impl.applyPendingDelay();
+    
+    size_t written = 0;
+    impl.capture_frames.push(samples, count * impl.num_channels, [&impl, out, &written](const float* frame) {
+        impl.processFrame(frame, out + written);
+        written += impl.samples_per_frame;
+    });
     
-    // Accumulate samples
-    for (size_t i = 0; i < count; ++i) {
-        pImpl_->capture_accumulator.push_back(samples[i]);
+    return written;
+}
+
+std::vector<float> AudioPipeline::processCapture(const float* samples, size_t count) {
+    std::vector<float> output(count + pImpl_->samples_per_frame);
+    output.resize(processCapture(samples, count, output.data()));
+    return output;
+}
+
+bool AudioPipeline::prepareRealtime() {
+    Impl& impl = *pImpl_;
+    impl.unlockRegions();
+    if (!impl.initialized) return true;
+    
+    // Pipeline state proper: AGC, stage counters, metrics, framing indices
+    bool ok = impl.lockRegion(&impl, sizeof(impl));
+    ok &= impl.lockRegion(impl.render_frames.staging(), impl.render_frames.frameSize() * sizeof(float));
+    ok &= impl.lockRegion(impl.capture_frames.staging(), impl.capture_frames.frameSize() * sizeof(float));
+    
+    // The WebRTC stages keep their filter and estimator state in heap blocks
+    // of their own that cannot be reached from here; those were written (so
+    // faulted in) when the stages were built. The objects and the frame
+    // buffers every stage reads and writes are locked.
+    ok &= impl.lockRegion(impl.aec3.get(), sizeof(webrtc::EchoCanceller3));
+    ok &= impl.lockAudioBuffer(impl.render_buffer.get(), 1);
+    ok &= impl.lockAudioBuffer(impl.capture_buffer.get(), impl.num_channels);
+#ifdef RTV_HAS_WEBRTC_HPF
+    ok &= impl.lockRegion(impl.high_pass.get(), sizeof(webrtc::HighPassFilter));
+#endif
+#ifdef RTV_HAS_WEBRTC_NS
+    ok &= impl.lockRegion(impl.noise_suppressor.get(), sizeof(webrtc::NoiseSuppressor));
+#endif
+    
+    if (impl.beamformer) {
+        impl.beamformer->visitBuffers([&](const void* data, size_t bytes) {
+            ok &= impl.lockRegion(data, bytes);
+        });
     }
     
-    // Process complete frames
-    while (pImpl_->capture_accumulator.size() >= static_cast<size_t>(pImpl_->samples_per_frame)) {
-        // Copy to audio buffer
-        float* const* buffer_data = pImpl_->capture_buffer->channels_f();
-        for (int i = 0; i < pImpl_->samples_per_frame; ++i) {
-            buffer_data[0][i] = pImpl_->capture_accumulator[i];
-        }
-        
-        // Analyze and process capture (microphone) signal
-        pImpl_->aec3->AnalyzeCapture(pImpl_->capture_buffer.get());
-        pImpl_->aec3->ProcessCapture(pImpl_->capture_buffer.get(), false);
-        
-        // Copy processed audio to output
-        const float* const* processed = pImpl_->capture_buffer->channels_const_f();
-        for (int i = 0; i < pImpl_->samples_per_frame; ++i) {
-            output.push_back(processed[0][i]);
+    // Worker mode: hand-off rings and the worker's scratch
+    if (impl.capture_ring) {
+        for (std::span<const float> storage : {impl.capture_ring->storage(), impl.render_ring->storage(),
+                                               impl.output_ring->storage()}) {
+            ok &= impl.lockRegion(storage.data(), storage.size_bytes());
         }
-        
-        // Remove processed samples
-        pImpl_->capture_accumulator.erase(
-            pImpl_->capture_accumulator.begin(),
-            pImpl_->capture_accumulator.begin() + pImpl_->samples_per_frame
-        );
+        std::span<const int64_t> stamps = impl.capture_stamps->storage();
+        ok &= impl.lockRegion(stamps.data(), stamps.size_bytes());
+        ok &= impl.lockVector(impl.worker_frame);
+        ok &= impl.lockVector(impl.worker_out);
+        ok &= impl.lockVector(impl.render_scratch);
     }
     
-    return output;
+    return ok;
+}
+
+void AudioPipeline::releaseRealtime() {
+    pImpl_->unlockRegions();
+}
+
+void AudioPipeline::setWorkerPriority(int priority, bool round_robin) {
+    Impl& impl = *pImpl_;
+    impl.worker_round_robin.store(round_robin, std::memory_order_relaxed);
+    impl.worker_priority.store(priority, std::memory_order_release);
+    impl.worker_sched_pending.store(true, std::memory_order_release);
+    
+    // Picked up within one wait; wake it so that happens now
+    if (impl.worker_running) impl.capture_stamps->wake();
+}
+
+bool AudioPipeline::isWorkerRealtime() const {
+    return pImpl_->worker_realtime.load(std::memory_order_relaxed);
+}
+
+size_t AudioPipeline::lockedBytes() const {
+    return pImpl_->locked_bytes;
+}
+
+int AudioPipeline::samplesPerFrame() const {
+    return pImpl_->samples_per_frame;
 }
 
 float AudioPipeline::getERLE() const {
-    return pImpl_->erle;
+    return static_cast<float>(pImpl_->metrics.load().erle_db);
 }
 
 bool AudioPipeline::isEchoDetected() const {
-    return pImpl_->echo_detected;
+    return pImpl_->metrics.load().echo_detected;
+}
+
+AecMetrics AudioPipeline::getMetrics() const {
+    return pImpl_->metrics.load();
+}
+
+void AudioPipeline::setMetricsInterval(int frames) {
+    pImpl_->metrics_interval.store(std::max(1, frames), std::memory_order_relaxed);
+}
+
+void AudioPipeline::setEchoThreshold(float likelihood) {
+    pImpl_->echo_threshold.store(std::clamp(likelihood, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void AudioPipeline::setDelayHint(int delay_ms) {
+    delay_ms = std::max(0, delay_ms);
+    pImpl_->delay_hint_ms.store(delay_ms, std::memory_order_relaxed);
+    pImpl_->pending_delay_ms.store(delay_ms, std::memory_order_release);
+    std::cout << "[AudioPipeline] Delay hint: " << delay_ms << "ms" << std::endl;
+}
+
+int AudioPipeline::delayHint() const {
+    return pImpl_->delay_hint_ms.load(std::memory_order_relaxed);
+}
+
+int AudioPipeline::sampleRate() const {
+    return sample_rate_;
+}
+
+void AudioPipeline::setStageEnabled(PipelineStage stage, bool enabled) {
+    StageCounters& counters = pImpl_->stage(stage);
+    if (enabled && !counters.available) {
+        std::cerr << "[AudioPipeline] " << stageName(stage) << " not available in this build" << std::endl;
+        enabled = false;
+    }
+    counters.enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AudioPipeline::isStageEnabled(PipelineStage stage) const {
+    return pImpl_->stage(stage).enabled.load(std::memory_order_relaxed);
+}
+
+PipelineStats AudioPipeline::getStats() const {
+    PipelineStats stats;
+    for (size_t i = 0; i < kPipelineStages; ++i) {
+        stats.stages[i] = pImpl_->stages[i].snapshot();
+    }
+    stats.frames = pImpl_->frames_processed.load(std::memory_order_relaxed);
+    stats.worker_thread = pImpl_->worker_running.load(std::memory_order_relaxed);
+    stats.frames_late = pImpl_->frames_late.load(std::memory_order_relaxed);
+    stats.frames_dropped = pImpl_->frames_dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AudioPipeline::resetStats() {
+    for (StageCounters& counters : pImpl_->stages) counters.reset();
+    pImpl_->frames_processed.store(0, std::memory_order_relaxed);
+    pImpl_->frames_late.store(0, std::memory_order_relaxed);
+    pImpl_->frames_dropped.store(0, std::memory_order_relaxed);
 }
 
 void AudioPipeline::reset() {
-    pImpl_->render_accumulator.clear();
-    pImpl_->capture_accumulator.clear();
-    pImpl_->erle = 0.0f;
-    pImpl_->echo_detected = false;
+    // The worker owns the stage state; pause it while that is cleared
+    const bool restart = pImpl_->worker_running;
+    if (restart) {
+        pImpl_->stopWorker();
+        pImpl_->capture_ring->clear();
+        pImpl_->capture_stamps->clear();
+        pImpl_->render_ring->clear();
+        pImpl_->output_ring->clear();
+    }
+    
+    pImpl_->render_frames.clear();
+    pImpl_->capture_frames.clear();
+    pImpl_->render_active_frames.store(0, std::memory_order_relaxed);
+    pImpl_->frames_since_update = 0;
+    pImpl_->frames_total = 0;
+    pImpl_->updates = 0;
+    pImpl_->capture_energy = 0.0;
+    pImpl_->residual_energy = 0.0;
+    pImpl_->metrics.store(AecMetrics{});
+    pImpl_->agc.reset();
+    if (pImpl_->beamformer) pImpl_->beamformer->reset();
+    
+    if (restart) {
+        pImpl_->worker_running = true;
+        pImpl_->worker = std::thread([impl = pImpl_.get()]() { impl->workerLoop(); });
+    }
     
     std::cout << "[AudioPipeline] Reset" << std::endl;
 }
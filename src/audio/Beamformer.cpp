@@ -0,0 +1,138 @@
+/**
+ * Beamformer.cpp - Delay-and-sum beamformer for small mic arrays
+ */
+
+#include "rtv/audio/Beamformer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace rtv::audio {
+
+namespace {
+
+// Correlation memory per block (~200ms time constant at 10ms blocks)
+constexpr double kCorrelationDecay = 0.95;
+
+// Blocks between delay re-estimates
+constexpr int kUpdateBlocks = 10;
+
+// Only blocks above -50 dBFS on mic 0 steer the beam
+constexpr double kMinEnergy = 1e-5;
+
+} // namespace
+
+Beamformer::Beamformer(int num_channels, int max_delay_samples)
+    : num_channels_(std::max(1, num_channels))
+    , max_delay_(std::max(0, max_delay_samples))
+    , delays_(num_channels_, 0)
+    , history_(num_channels_)
+    , correlation_(num_channels_, std::vector<double>(2 * max_delay_ + 1, 0.0)) {
+    ensureCapacity(480);  // 10ms at 48kHz
+}
+
+void Beamformer::ensureCapacity(size_t frames) {
+    if (frames <= block_capacity_) return;
+    block_capacity_ = frames;
+    for (auto& h : history_) {
+        h.resize(2 * max_delay_ + block_capacity_, 0.0f);
+    }
+}
+
+void Beamformer::process(const float* const* channels, size_t frames, float* out) {
+    ensureCapacity(frames);
+    const size_t past = 2 * static_cast<size_t>(max_delay_);
+
+    // Append the block behind each channel's history; out may alias an
+    // input from here on
+    for (int c = 0; c < num_channels_; ++c) {
+        std::copy_n(channels[c], frames, history_[c].data() + past);
+    }
+
+    if (adaptive_ && num_channels_ > 1) {
+        accumulateCorrelation(frames);
+        if (++blocks_since_update_ >= kUpdateBlocks) {
+            blocks_since_update_ = 0;
+            updateDelays();
+        }
+    }
+
+    // Mic 0 at t - D, mic c at t - D + d_c
+    const float scale = 1.0f / num_channels_;
+    const float* ref = history_[0].data() + max_delay_;
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] = ref[i];
+    }
+    for (int c = 1; c < num_channels_; ++c) {
+        const float* src = history_[c].data() + max_delay_ + delays_[c];
+        for (size_t i = 0; i < frames; ++i) {
+            out[i] += src[i];
+        }
+    }
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] *= scale;
+    }
+
+    // Keep the newest 2D samples as history for the next block
+    for (auto& h : history_) {
+        std::copy_n(h.data() + frames, past, h.data());
+    }
+}
+
+void Beamformer::accumulateCorrelation(size_t frames) {
+    const float* ref = history_[0].data() + max_delay_;
+
+    double refEnergy = 0.0;
+    for (size_t i = 0; i < frames; ++i) refEnergy += ref[i] * ref[i];
+    if (refEnergy < kMinEnergy * frames) return;
+
+    for (int c = 1; c < num_channels_; ++c) {
+        const float* mic = history_[c].data() + max_delay_;
+
+        double micEnergy = 0.0;
+        for (size_t i = 0; i < frames; ++i) micEnergy += mic[i] * mic[i];
+        if (micEnergy <= 0.0) continue;
+        const double norm = 1.0 / std::sqrt(refEnergy * micEnergy);
+
+        std::vector<double>& corr = correlation_[c];
+        for (int lag = -max_delay_; lag <= max_delay_; ++lag) {
+            const float* shifted = mic + lag;
+            double acc = 0.0;
+            for (size_t i = 0; i < frames; ++i) acc += ref[i] * shifted[i];
+            double& slot = corr[lag + max_delay_];
+            slot = slot * kCorrelationDecay + acc * norm;
+        }
+    }
+}
+
+void Beamformer::updateDelays() {
+    for (int c = 1; c < num_channels_; ++c) {
+        const std::vector<double>& corr = correlation_[c];
+        auto best = std::max_element(corr.begin(), corr.end());
+        // Nothing accumulated yet (silence so far): keep the current steering
+        if (*best <= 0.0) continue;
+        delays_[c] = static_cast<int>(best - corr.begin()) - max_delay_;
+    }
+}
+
+void Beamformer::setSteering(const std::vector<int>& delays) {
+    adaptive_ = false;
+    for (int c = 0; c < num_channels_; ++c) {
+        int d = c < static_cast<int>(delays.size()) ? delays[c] : 0;
+        delays_[c] = std::clamp(d, -max_delay_, max_delay_);
+    }
+    delays_[0] = 0;
+}
+
+void Beamformer::setAdaptive(bool adaptive) {
+    adaptive_ = adaptive;
+    blocks_since_update_ = 0;
+}
+
+void Beamformer::reset() {
+    for (auto& h : history_) std::fill(h.begin(), h.end(), 0.0f);
+    for (auto& corr : correlation_) std::fill(corr.begin(), corr.end(), 0.0);
+    if (adaptive_) std::fill(delays_.begin(), delays_.end(), 0);
+    blocks_since_update_ = 0;
+}
+
+} // namespace rtv::audio
@@ -0,0 +1,14 @@
+/**
+ * BroadcastRing.cpp - Lock-free SPMC broadcast ring
+ * Note: Most logic is in header (template class)
+ */
+
+#include "rtv/audio/BroadcastRing.hpp"
+
+namespace rtv::audio {
+
+// Explicit instantiation for common types
+template class BroadcastRing<float>;
+template class BroadcastRing<int16_t>;
+
+} // namespace rtv::audio
@@ -0,0 +1,245 @@
+/**
+ * DelayCalibrator.cpp - Chirp round-trip measurement for the AEC3 delay hint
+ */
+
+#include "rtv/audio/DelayCalibrator.hpp"
+#include "rtv/audio/AudioEngine.hpp"
+#include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/PlaybackMixer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace rtv::audio {
+
+using json = nlohmann::json;
+
+// Reference samples quieter than this are treated as silence around the chirp
+constexpr float REFERENCE_FLOOR = 1e-4f;
+
+// Extra time allowed for the chirp to reach the device and its echo to return
+constexpr int SETTLE_MS = 200;
+
+DelayCalibrator::DelayCalibrator(const DelayCalibratorConfig& config)
+    : config_(config)
+{}
+
+std::vector<float> DelayCalibrator::makeChirp(int sample_rate, int duration_ms,
+                                              float f0, float f1, float level) {
+    const size_t n = static_cast<size_t>(sample_rate) * duration_ms / 1000;
+    const size_t fade = std::min(n / 2, static_cast<size_t>(sample_rate / 200));  // 5ms
+    const double duration = static_cast<double>(n) / sample_rate;
+    const double sweep = (f1 - f0) / (2.0 * duration);
+
+    std::vector<float> chirp(n);
+    for (size_t i = 0; i < n; ++i) {
+        double t = static_cast<double>(i) / sample_rate;
+        double phase = 2.0 * M_PI * (f0 * t + sweep * t * t);
+
+        double gain = level;
+        size_t edge = std::min(i, n - 1 - i);
+        if (edge < fade) {
+            gain *= 0.5 - 0.5 * std::cos(M_PI * edge / fade);
+        }
+        chirp[i] = static_cast<float>(gain * std::sin(phase));
+    }
+    return chirp;
+}
+
+int DelayCalibrator::findDelay(const float* reference, size_t reference_count,
+                               const float* capture, size_t capture_count,
+                               size_t max_lag, float* confidence) {
+    if (confidence) *confidence = 0.0f;
+
+    // Correlate only the audible part of the reference
+    size_t begin = 0;
+    while (begin < reference_count && std::abs(reference[begin]) < REFERENCE_FLOOR) ++begin;
+    size_t end = reference_count;
+    while (end > begin && std::abs(reference[end - 1]) < REFERENCE_FLOOR) --end;
+    if (begin == end || end > capture_count) return -1;
+
+    const size_t len = end - begin;
+    const float* ref = reference + begin;
+    max_lag = std::min(max_lag, capture_count - end);
+
+    double refEnergy = 0.0;
+    for (size_t i = 0; i < len; ++i) refEnergy += static_cast<double>(ref[i]) * ref[i];
+
+    // Capture energy under the window, slid one sample per lag
+    const float* cap = capture + begin;
+    double capEnergy = 0.0;
+    for (size_t i = 0; i < len; ++i) capEnergy += static_cast<double>(cap[i]) * cap[i];
+
+    int bestLag = -1;
+    double best = 0.0;
+    for (size_t lag = 0; lag <= max_lag; ++lag) {
+        const float* window = cap + lag;
+        float dot = 0.0f;
+        for (size_t i = 0; i < len; ++i) dot += ref[i] * window[i];
+
+        double denom = std::sqrt(refEnergy * capEnergy);
+        double score = denom > 0.0 ? std::abs(dot) / denom : 0.0;
+        if (score > best) {
+            best = score;
+            bestLag = static_cast<int>(lag);
+        }
+
+        if (lag < max_lag) {
+            capEnergy += static_cast<double>(window[len]) * window[len]
+                       - static_cast<double>(window[0]) * window[0];
+            capEnergy = std::max(capEnergy, 0.0);
+        }
+    }
+
+    if (confidence) *confidence = static_cast<float>(std::min(best, 1.0));
+    return bestLag;
+}
+
+bool DelayCalibrator::calibrate(AudioEngine& engine, AudioPipeline& pipeline, DelayCalibration& result) {
+    result = DelayCalibration{};
+
+    const AudioConfig& audio = engine.config();
+    const int rate = pipeline.sampleRate();
+
+    // PortAudio's view: the render tap already holds back the output latency,
+    // so what AEC3 still has to cover is the input side plus one block
+    AudioStats stats = engine.getStats();
+    result.reported_ms = stats.input.device_latency_ms + stats.output.device_latency_ms;
+    int estimated_ms = static_cast<int>(std::lround(
+        stats.input.device_latency_ms + 1000.0 * audio.frames_per_buffer / rate));
+    result.delay_ms = estimated_ms;
+
+    if (!engine.isRunning()) {
+        lastError_ = "AudioEngine is not running";
+        std::cerr << "[DelayCalibrator] " << lastError_ << std::endl;
+        pipeline.setDelayHint(result.delay_ms);
+        return false;
+    }
+
+    // Recording window: chirp, longest delay searched, device buffering
+    const int window_ms = config_.chirp_ms + config_.max_delay_ms +
+        static_cast<int>(result.reported_ms) + SETTLE_MS;
+    const size_t capacity = static_cast<size_t>(rate) * window_ms / 1000;
+    std::vector<float> reference;
+    std::vector<float> capture;
+    reference.reserve(capacity);
+    capture.reserve(capacity);
+
+    // Runs under the engine's callback lock; detaching below fences it off
+    engine.setEchoPathObserver([&](const float* ref, size_t ref_count,
+                                   const float* cap, size_t cap_count) {
+        if (capture.size() >= capacity) return;
+        size_t n = std::min(cap_count, capacity - capture.size());
+        capture.insert(capture.end(), cap, cap + n);
+        size_t m = std::min(ref_count, capacity - reference.size());
+        reference.insert(reference.end(), ref, ref + m);
+    });
+
+    float f1 = std::min(config_.chirp_end_hz, 0.45f * std::min(rate, audio.output_sample_rate));
+    engine.queuePlayback(makeClip(makeChirp(audio.output_sample_rate, config_.chirp_ms,
+                                            config_.chirp_start_hz, f1, config_.chirp_level)));
+
+    std::cout << "[DelayCalibrator] Playing " << config_.chirp_ms << "ms chirp ("
+              << config_.chirp_start_hz << "-" << f1 << "Hz)..." << std::endl;
+
+    engine.waitForPlaybackDrained(std::chrono::milliseconds(window_ms));
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        config_.max_delay_ms + static_cast<int>(result.reported_ms) + SETTLE_MS));
+    engine.setEchoPathObserver(nullptr);
+
+    if (capture.empty() || reference.empty()) {
+        lastError_ = "No echo path data recorded (is the AudioPipeline attached?)";
+        std::cerr << "[DelayCalibrator] " << lastError_ << std::endl;
+        pipeline.setDelayHint(result.delay_ms);
+        return false;
+    }
+
+    // Both streams advance one block per callback; align their lengths
+    size_t n = std::min(reference.size(), capture.size());
+    size_t max_lag = static_cast<size_t>(rate) * config_.max_delay_ms / 1000;
+    int lag = findDelay(reference.data(), n, capture.data(), capture.size(),
+                        max_lag, &result.confidence);
+
+    if (lag >= 0 && result.confidence >= config_.min_confidence) {
+        result.measured = true;
+        result.measured_ms = 1000.0 * lag / rate;
+        result.delay_ms = static_cast<int>(std::lround(result.measured_ms));
+        std::cout << "[DelayCalibrator] Measured " << result.measured_ms << "ms (confidence "
+                  << result.confidence << ", PortAudio reports " << result.reported_ms
+                  << "ms round trip)" << std::endl;
+    } else {
+        std::cerr << "[DelayCalibrator] Chirp not found (confidence " << result.confidence
+                  << "), using PortAudio estimate " << estimated_ms << "ms" << std::endl;
+    }
+
+    pipeline.setDelayHint(result.delay_ms);
+    return true;
+}
+
+std::string DelayCalibrator::deviceKey(const AudioEngine& engine) {
+    const AudioConfig& audio = engine.config();
+    return engine.inputDeviceName() + " -> " + engine.outputDeviceName() +
+           " @" + std::to_string(audio.sample_rate) + "/" +
+           std::to_string(audio.output_sample_rate) + "Hz" +
+           (audio.full_duplex ? " duplex" : "");
+}
+
+bool DelayCalibrator::load(const std::string& path, const std::string& device_key, DelayCalibration& result) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    try {
+        json root = json::parse(file);
+        if (!root.contains(device_key)) return false;
+
+        const json& entry = root[device_key];
+        result.delay_ms = entry.value("delay_ms", 0);
+        result.measured = entry.value("measured", false);
+        result.measured_ms = entry.value("measured_ms", 0.0);
+        result.reported_ms = entry.value("reported_ms", 0.0);
+        result.confidence = entry.value("confidence", 0.0f);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "[DelayCalibrator] Ignoring " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DelayCalibrator::save(const std::string& path, const std::string& device_key, const DelayCalibration& result) {
+    // Keep entries for other devices
+    json root = json::object();
+    {
+        std::ifstream existing(path);
+        if (existing) {
+            try {
+                root = json::parse(existing);
+            } catch (const std::exception&) {
+                root = json::object();
+            }
+        }
+    }
+
+    root[device_key] = {
+        {"delay_ms", result.delay_ms},
+        {"measured", result.measured},
+        {"measured_ms", result.measured_ms},
+        {"reported_ms", result.reported_ms},
+        {"confidence", result.confidence}
+    };
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "[DelayCalibrator] Cannot write " << path << std::endl;
+        return false;
+    }
+    file << root.dump(2) << std::endl;
+    return true;
+}
+
+} // namespace rtv::audio
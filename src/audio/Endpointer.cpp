@@ -0,0 +1,157 @@
+/**
+ * Endpointer.cpp - Adaptive end-of-turn detection
+ */
+
+#include "rtv/audio/Endpointer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <string_view>
+
+namespace rtv::audio {
+
+namespace {
+
+// Silences shorter than this are VAD flicker inside a word, not pauses
+constexpr int MIN_PAUSE_MS = 80;
+
+// Pauses needed before the learned statistics replace the default
+constexpr uint64_t MIN_PAUSES = 3;
+
+// Weight of each new pause in the running statistics
+constexpr double PAUSE_ALPHA = 0.1;
+
+// Least headroom above the mean pause, for speakers with very even pauses
+constexpr double MIN_PAUSE_SLACK_MS = 100.0;
+
+constexpr double COMPLETE_FACTOR = 0.5;
+
+// Last words that promise more to come (Portuguese and English)
+constexpr std::array<std::string_view, 20> CONTINUATION_WORDS = {
+    "e", "mas", "ou", "que", "porque", "então", "tipo", "né", "é", "hum",
+    "and", "but", "or", "so", "because", "the", "a", "to", "um", "uh",
+};
+
+} // namespace
+
+Endpointer::Endpointer(const EndpointerConfig& config) {
+    setConfig(config);
+}
+
+void Endpointer::setConfig(const EndpointerConfig& config) {
+    config_ = config;
+    config_.max_timeout_ms = std::max(config_.max_timeout_ms, 1);
+    config_.min_timeout_ms = std::clamp(config_.min_timeout_ms, 1, config_.max_timeout_ms);
+    config_.default_timeout_ms = std::clamp(config_.default_timeout_ms,
+                                            config_.min_timeout_ms, config_.max_timeout_ms);
+}
+
+bool Endpointer::update(bool speech, int duration_ms) {
+    if (speech) {
+        if (!in_turn_) {
+            in_turn_ = true;
+            speech_ms_ = 0;
+            hint_ = TranscriptHint::None;
+        } else if (silence_ms_ >= MIN_PAUSE_MS) {
+            // Speech resumed, so that silence was a pause, not an ending
+            learnPause(silence_ms_);
+        }
+        speech_ms_ += duration_ms;
+        silence_ms_ = 0;
+        return false;
+    }
+
+    if (!in_turn_) return false;
+
+    silence_ms_ += duration_ms;
+    const int timeout = currentTimeoutMs();
+    if (silence_ms_ < timeout) return false;
+
+    last_.delay_ms = silence_ms_;
+    last_.timeout_ms = timeout;
+    last_.speech_ms = speech_ms_;
+    last_.hint = hint_;
+
+    in_turn_ = false;
+    silence_ms_ = 0;
+    return true;
+}
+
+void Endpointer::commitTurn(bool accepted) {
+    if (!accepted) return;
+
+    const int delay = last_.delay_ms;
+    stats_.turns++;
+    if (last_.hint == TranscriptHint::Complete) stats_.early_turns++;
+    delay_total_ += delay;
+    stats_.min_delay_ms = stats_.turns == 1 ? delay : std::min(stats_.min_delay_ms, delay);
+    stats_.max_delay_ms = std::max(stats_.max_delay_ms, delay);
+}
+
+void Endpointer::learnPause(int pause_ms) {
+    if (pauses_ == 0) {
+        pause_mean_ = pause_ms;
+        pause_var_ = 0.0;
+    } else {
+        const double diff = pause_ms - pause_mean_;
+        pause_mean_ += PAUSE_ALPHA * diff;
+        pause_var_ = (1.0 - PAUSE_ALPHA) * (pause_var_ + PAUSE_ALPHA * diff * diff);
+    }
+    pauses_++;
+}
+
+void Endpointer::setPartialTranscript(const std::string& text) {
+    if (in_turn_) hint_ = classify(text);
+}
+
+TranscriptHint Endpointer::classify(const std::string& text) {
+    size_t end = text.find_last_not_of(" \t\r\n");
+    if (end == std::string::npos) return TranscriptHint::None;
+
+    std::string_view trimmed(text.data(), end + 1);
+    if (trimmed.ends_with("...") || trimmed.ends_with(",")) return TranscriptHint::Incomplete;
+    if (trimmed.ends_with(".") || trimmed.ends_with("?") || trimmed.ends_with("!")) {
+        return TranscriptHint::Complete;
+    }
+
+    size_t start = trimmed.find_last_of(" \t\r\n");
+    std::string word(trimmed.substr(start == std::string_view::npos ? 0 : start + 1));
+    std::transform(word.begin(), word.end(), word.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (std::string_view w : CONTINUATION_WORDS) {
+        if (word == w) return TranscriptHint::Incomplete;
+    }
+    return TranscriptHint::None;
+}
+
+int Endpointer::currentTimeoutMs() const {
+    if (hint_ == TranscriptHint::Incomplete) return config_.max_timeout_ms;
+
+    double timeout = pauses_ >= MIN_PAUSES
+        ? pause_mean_ + std::max(config_.pause_margin * std::sqrt(pause_var_), MIN_PAUSE_SLACK_MS)
+        : config_.default_timeout_ms;
+    if (hint_ == TranscriptHint::Complete) timeout *= COMPLETE_FACTOR;
+
+    return std::clamp(static_cast<int>(std::lround(timeout)),
+                      config_.min_timeout_ms, config_.max_timeout_ms);
+}
+
+EndpointerStats Endpointer::stats() const {
+    EndpointerStats s = stats_;
+    s.mean_delay_ms = s.turns > 0 ? delay_total_ / s.turns : 0.0;
+    s.pause_mean_ms = pause_mean_;
+    s.pause_stddev_ms = std::sqrt(pause_var_);
+    s.pauses = pauses_;
+    return s;
+}
+
+void Endpointer::reset() {
+    in_turn_ = false;
+    speech_ms_ = 0;
+    silence_ms_ = 0;
+    hint_ = TranscriptHint::None;
+}
+
+} // namespace rtv::audio
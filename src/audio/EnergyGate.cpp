@@ -0,0 +1,138 @@
+/**
+ * EnergyGate.cpp - Cheap level pre-gate for the speech detectors
+ */
+
+#include "rtv/audio/EnergyGate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace rtv::audio {
+
+namespace {
+
+// The floor follows dips in the level quickly and climbs slowly, so it
+// settles on the quiet gaps between words rather than on speech
+constexpr float FLOOR_FALL = 0.3f;
+constexpr float FLOOR_RISE_DB_PER_S = 2.0f;
+
+constexpr double FULL_SCALE_SQ = 32768.0 * 32768.0;
+
+} // namespace
+
+FrameLevel measureLevel(const int16_t* frame, size_t count) {
+    FrameLevel level;
+    if (count == 0) return level;
+
+    uint64_t energy = 0;
+    size_t crossings = 0;
+    size_t i = 0;
+    size_t j = 0;
+#if defined(__AVX2__)
+    // madd pairs are at most 2 * 32768^2 = 2^31: exact as uint32, summed in 64 bits
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 16 <= count; i += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frame + i));
+        __m256i sq = _mm256_madd_epi16(x, x);
+        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sq)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sq, 1)));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    energy = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    // Sign change between neighbours: sign bit of a ^ b, one per high byte
+    for (; j + 17 <= count; j += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frame + j));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frame + j + 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_xor_si256(a, b)));
+        crossings += std::popcount(mask & 0xAAAAAAAAu);
+    }
+#endif
+    for (; i < count; ++i) {
+        energy += static_cast<uint64_t>(static_cast<int32_t>(frame[i]) * frame[i]);
+    }
+    for (; j + 1 < count; ++j) {
+        if ((frame[j] ^ frame[j + 1]) < 0) ++crossings;
+    }
+
+    double mean_sq = energy / (FULL_SCALE_SQ * count);
+    level.dbfs = static_cast<float>(10.0 * std::log10(std::max(mean_sq, 1e-12)));
+    level.zcr = static_cast<float>(crossings) / count;
+    return level;
+}
+
+EnergyGate::EnergyGate(size_t frame_size, int sample_rate, const EnergyGateConfig& config)
+    : config_(config)
+    , frame_size_(std::max<size_t>(frame_size, 1))
+    , frame_s_(static_cast<float>(frame_size_) / sample_rate)
+{
+    const size_t frame_ms = std::max<size_t>(frame_size_ * 1000 / sample_rate, 1);
+    hangover_frames_ = static_cast<int>((std::max(config_.hangover_ms, 0) + frame_ms - 1) / frame_ms);
+    lookback_frames_ = (static_cast<size_t>(std::max(config_.lookback_ms, 0)) + frame_ms - 1) / frame_ms;
+    lookback_.assign(lookback_frames_ * frame_size_, 0);
+}
+
+bool EnergyGate::admit(const int16_t* frame) {
+    stats_.frames++;
+    FrameLevel level = measureLevel(frame, frame_size_);
+
+    if (!primed_) {
+        floor_dbfs_ = std::max(level.dbfs, config_.min_floor_dbfs);
+        primed_ = true;
+    }
+
+    const float above = level.dbfs - floor_dbfs_;
+    const bool loud = above >= config_.open_db ||
+                      (above >= config_.fricative_db && level.zcr >= config_.fricative_zcr);
+
+    if (level.dbfs < floor_dbfs_) {
+        floor_dbfs_ += FLOOR_FALL * (level.dbfs - floor_dbfs_);
+    } else {
+        floor_dbfs_ = std::min(level.dbfs, floor_dbfs_ + FLOOR_RISE_DB_PER_S * frame_s_);
+    }
+    floor_dbfs_ = std::max(floor_dbfs_, config_.min_floor_dbfs);
+
+    if (loud) {
+        hangover_left_ = hangover_frames_;
+        return true;
+    }
+    if (hangover_left_ > 0) {
+        hangover_left_--;
+        return true;
+    }
+    return false;
+}
+
+void EnergyGate::remember(const int16_t* frame) {
+    stats_.skipped++;
+    if (lookback_frames_ == 0) return;
+
+    std::copy_n(frame, frame_size_, lookback_.begin() + next_ * frame_size_);
+    next_ = (next_ + 1) % lookback_frames_;
+    held_ = std::min(held_ + 1, lookback_frames_);
+}
+
+const int16_t* EnergyGate::lookbackFrame(size_t i) const {
+    const size_t oldest = (next_ + lookback_frames_ - held_) % lookback_frames_;
+    return lookback_.data() + ((oldest + i) % lookback_frames_) * frame_size_;
+}
+
+EnergyGateStats EnergyGate::stats() const {
+    EnergyGateStats s = stats_;
+    s.noise_floor_dbfs = floor_dbfs_;
+    return s;
+}
+
+void EnergyGate::reset() {
+    hangover_left_ = 0;
+    next_ = 0;
+    held_ = 0;
+}
+
+} // namespace rtv::audio
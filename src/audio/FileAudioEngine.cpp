@@ -0,0 +1,254 @@
+/**
+ * FileAudioEngine.cpp - WAV-file driven AudioEngine backend
+ *
+ * Lets AEC/VAD/STT/TTS pipelines run on build hosts without a sound card.
+ * Input blocks come from a WAV file, playback is rendered by the engine into
+ * a WAV file, and the clock is either paced to real time or free-running.
+ */
+
+#include "rtv/audio/FileAudioEngine.hpp"
+#include "rtv/audio/WavFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace rtv::audio {
+
+struct FileAudioBackend::Impl {
+    FileAudioConfig config;
+
+    std::vector<float> input;
+    size_t inputPos = 0;
+
+    WavWriter output;
+    AudioIO* io = nullptr;
+    bool fullDuplex = false;
+
+    std::thread clockThread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> frames{0};
+
+    // Output frames owed per input block, carried as a fraction
+    double outputPerInput = 1.5;
+    double outputCarry = 0.0;
+
+    std::vector<float> inBlock;
+    std::vector<float> outBlock;
+
+    /**
+     * Render one playback period and deliver the matching input block.
+     * @return false once input is exhausted and playback has drained
+     */
+    bool tick(int& drainBlocksLeft) {
+        const size_t blockSize = inBlock.size();
+        size_t copied = 0;
+
+        while (copied < blockSize && inputPos < input.size()) {
+            size_t n = std::min(blockSize - copied, input.size() - inputPos);
+            std::copy_n(input.begin() + inputPos, n, inBlock.begin() + copied);
+            copied += n;
+            inputPos += n;
+            if (inputPos == input.size() && config.loop_input) {
+                inputPos = 0;
+            }
+        }
+
+        bool inputDone = (copied == 0);
+        if (inputDone) {
+            if (drainBlocksLeft <= 0 || !io->playbackPending()) {
+                return false;
+            }
+            --drainBlocksLeft;
+        }
+        std::fill(inBlock.begin() + copied, inBlock.end(), 0.0f);
+
+        const BlockStatus status;
+        if (fullDuplex) {
+            // Files have no converter latency: the block plays as it is captured
+            BlockTiming timing;
+            timing.input_adc_time = static_cast<double>(frames) / config.sample_rate;
+            timing.output_dac_time = timing.input_adc_time;
+            timing.current_time = timing.input_adc_time;
+
+            io->onDuplex(inBlock.data(), outBlock.data(), blockSize, timing, status);
+            output.write(outBlock.data(), blockSize);
+        } else {
+            // Advance the output side by the same wall-clock duration
+            outputCarry += blockSize * outputPerInput;
+            size_t outFrames = static_cast<size_t>(outputCarry);
+            outputCarry -= outFrames;
+
+            io->onRender(outBlock.data(), outFrames, status);
+            output.write(outBlock.data(), outFrames);
+            io->onCapture(inBlock.data(), blockSize, status);
+        }
+        frames += blockSize;
+
+        return true;
+    }
+
+    void clockLoop() {
+        const auto period = std::chrono::duration<double>(
+            static_cast<double>(config.frames_per_buffer) / config.sample_rate);
+        int drainBlocksLeft = static_cast<int>(
+            static_cast<int64_t>(config.drain_timeout_ms) * config.sample_rate /
+            (1000 * config.frames_per_buffer));
+
+        auto next = std::chrono::steady_clock::now();
+
+        while (running) {
+            if (!tick(drainBlocksLeft)) {
+                break;
+            }
+
+            if (config.clock == ClockMode::Realtime) {
+                next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+                std::this_thread::sleep_until(next);
+            }
+        }
+
+        running = false;
+        output.close();
+    }
+};
+
+FileAudioBackend::FileAudioBackend(const FileAudioConfig& config)
+    : pImpl_(std::make_unique<Impl>())
+{
+    pImpl_->config = config;
+}
+
+FileAudioBackend::~FileAudioBackend() {
+    close();
+}
+
+bool FileAudioBackend::initialize(std::string& error) {
+    const FileAudioConfig& config = pImpl_->config;
+
+    WavData wav;
+    if (!readWav(config.input_wav, wav, &error)) {
+        error = "Input WAV: " + error;
+        return false;
+    }
+
+    if (wav.sample_rate != config.sample_rate) {
+        error = "Input WAV is " + std::to_string(wav.sample_rate) +
+                "Hz, expected " + std::to_string(config.sample_rate) + "Hz";
+        return false;
+    }
+
+    pImpl_->input = downmixToMono(wav);
+    pImpl_->inputPos = 0;
+
+    std::cout << "[FileAudioEngine] Loaded " << config.input_wav << " ("
+              << pImpl_->input.size() << " samples, "
+              << (config.clock == ClockMode::Realtime ? "realtime" : "virtual") << " clock)"
+              << std::endl;
+
+    return true;
+}
+
+bool FileAudioBackend::open(const AudioConfig& config, AudioIO& io, std::string& error) {
+    pImpl_->io = &io;
+    pImpl_->fullDuplex = config.full_duplex;
+
+    // The output WAV holds exactly what the engine renders
+    const int renderRate = config.full_duplex ? config.sample_rate : config.output_sample_rate;
+    const std::string& path = pImpl_->config.output_wav;
+    if (!path.empty() && !pImpl_->output.open(path, renderRate)) {
+        error = "Cannot open output WAV: " + path;
+        return false;
+    }
+
+    pImpl_->outputPerInput = static_cast<double>(renderRate) / config.sample_rate;
+    pImpl_->outputCarry = 0.0;
+    pImpl_->inBlock.assign(config.frames_per_buffer, 0.0f);
+    pImpl_->outBlock.assign(
+        static_cast<size_t>(config.frames_per_buffer * pImpl_->outputPerInput) + 1, 0.0f);
+    return true;
+}
+
+bool FileAudioBackend::start(std::string& error) {
+    if (pImpl_->clockThread.joinable()) {
+        pImpl_->clockThread.join();
+    }
+
+    pImpl_->running = true;
+    pImpl_->clockThread = std::thread([this]() { pImpl_->clockLoop(); });
+    return true;
+}
+
+void FileAudioBackend::close() {
+    pImpl_->running = false;
+    if (pImpl_->clockThread.joinable()) {
+        pImpl_->clockThread.join();
+    }
+    pImpl_->output.close();
+}
+
+bool FileAudioBackend::isActive() const {
+    return pImpl_->running;
+}
+
+std::string FileAudioBackend::deviceName(const AudioConfig& config, bool input) const {
+    return input ? pImpl_->config.input_wav : pImpl_->config.output_wav;
+}
+
+void FileAudioBackend::wait() {
+    if (pImpl_->clockThread.joinable()) {
+        pImpl_->clockThread.join();
+    }
+}
+
+double FileAudioBackend::streamTime() const {
+    return static_cast<double>(pImpl_->frames) / pImpl_->config.sample_rate;
+}
+
+uint64_t FileAudioBackend::framesProcessed() const {
+    return pImpl_->frames;
+}
+
+/**
+ * Engine settings implied by the files
+ */
+static AudioConfig engineConfig(const FileAudioConfig& config) {
+    AudioConfig audio;
+    audio.sample_rate = config.sample_rate;
+    audio.output_sample_rate = config.output_sample_rate;
+    audio.frames_per_buffer = config.frames_per_buffer;
+    audio.full_duplex = config.full_duplex;
+    return audio;
+}
+
+FileAudioEngine::FileAudioEngine(const FileAudioConfig& config)
+    : AudioEngine(engineConfig(config), std::make_unique<FileAudioBackend>(config))
+{
+}
+
+bool FileAudioEngine::runToCompletion() {
+    if (isRunning() || !start()) {
+        return false;
+    }
+
+    files().wait();
+    stop();
+    return true;
+}
+
+double FileAudioEngine::streamTime() const {
+    return files().streamTime();
+}
+
+uint64_t FileAudioEngine::framesProcessed() const {
+    return files().framesProcessed();
+}
+
+FileAudioBackend& FileAudioEngine::files() const {
+    return static_cast<FileAudioBackend&>(backend());
+}
+
+} // namespace rtv::audio
@@ -0,0 +1,196 @@
+/**
+ * PlaybackMixer.cpp - Lock-free multi-source playback mixer
+ */
+
+#include "rtv/audio/PlaybackMixer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rtv::audio {
+
+bool PlaybackMixer::enqueue(AudioClip clip, int source) {
+    if (source < 0 || source >= kMaxSources || !clip || clip->empty()) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    Source& src = sources_[source];
+    reclaimFinished(src);
+    
+    // Counted now, so the source stays active while the clip waits for a slot
+    src.queued.fetch_add(clip->size(), std::memory_order_relaxed);
+    src.pending.push_back(std::move(clip));
+    promotePending(src);
+    return true;
+}
+
+void PlaybackMixer::setGain(int source, float gain) {
+    if (source < 0 || source >= kMaxSources) return;
+    sources_[source].gain.store(gain, std::memory_order_relaxed);
+}
+
+void PlaybackMixer::clear(int source) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    for (int i = 0; i < kMaxSources; ++i) {
+        if (source >= 0 && i != source) continue;
+        Source& src = sources_[i];
+        
+        size_t dropped = 0;
+        for (const AudioClip& clip : src.pending) {
+            dropped += clip->size();
+        }
+        src.pending.clear();
+        src.queued.fetch_sub(dropped, std::memory_order_relaxed);
+        
+        src.flushTo.store(src.write.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+}
+
+bool PlaybackMixer::isActive() const {
+    return queuedSamples() > 0;
+}
+
+size_t PlaybackMixer::queuedSamples() const {
+    size_t total = 0;
+    for (const Source& src : sources_) {
+        total += src.queued.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t PlaybackMixer::samplesPlayed() const {
+    return played_.load(std::memory_order_relaxed);
+}
+
+bool PlaybackMixer::waitForDrain(std::chrono::milliseconds timeout, std::chrono::microseconds slice) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    
+    for (refill(); isActive(); refill()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto wait = std::min<std::chrono::steady_clock::duration>(deadline - now, slice);
+        drain_cv_.wait_for(lock, wait);
+    }
+    return true;
+}
+
+/**
+ * Release clips the real-time side has finished with. Caller holds control_mutex_.
+ */
+void PlaybackMixer::reclaimFinished(Source& src) {
+    uint64_t read = src.read.load(std::memory_order_acquire);
+    while (src.reclaim < read) {
+        Entry& entry = src.entries[src.reclaim % kQueueDepth];
+        entry.owner.reset();
+        entry.data = nullptr;
+        entry.size = 0;
+        ++src.reclaim;
+    }
+}
+
+/**
+ * Hand waiting clips to the real-time side while slots are free. Caller holds
+ * control_mutex_.
+ */
+void PlaybackMixer::promotePending(Source& src) {
+    uint64_t write = src.write.load(std::memory_order_relaxed);
+    
+    while (!src.pending.empty() && write - src.reclaim < kQueueDepth) {
+        Entry& entry = src.entries[write % kQueueDepth];
+        entry.owner = std::move(src.pending.front());
+        entry.data = entry.owner->data();
+        entry.size = entry.owner->size();
+        src.pending.pop_front();
+        
+        src.write.store(++write, std::memory_order_release);
+    }
+}
+
+void PlaybackMixer::refill() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    for (Source& src : sources_) {
+        reclaimFinished(src);
+        promotePending(src);
+    }
+}
+
+size_t PlaybackMixer::mix(float* out, size_t frames) {
+    std::memset(out, 0, frames * sizeof(float));
+    
+    size_t active = 0;
+    bool slotsFreed = false;
+    for (Source& src : sources_) {
+        active = std::max(active, mixSource(src, out, frames, slotsFreed));
+    }
+    
+    if (active > 0) {
+        for (size_t i = 0; i < active; ++i) {
+            out[i] = std::clamp(out[i], -1.0f, 1.0f);
+        }
+        played_.fetch_add(active, std::memory_order_relaxed);
+    }
+    
+    // Wake waiters on the block where the last queued sample went out, and
+    // whenever a finished clip frees a slot for one waiting on the control side
+    bool nowActive = isActive();
+    if (((was_active_ || active > 0) && !nowActive) || (slotsFreed && nowActive)) {
+        drain_cv_.notify_all();
+    }
+    was_active_ = nowActive;
+    
+    return active;
+}
+
+size_t PlaybackMixer::mixSource(Source& src, float* out, size_t frames, bool& slotsFreed) {
+    uint64_t read = src.read.load(std::memory_order_relaxed);
+    uint64_t write = src.write.load(std::memory_order_acquire);
+    
+    // Honour clear(): skip every clip queued before it was called
+    uint64_t flushTo = src.flushTo.load(std::memory_order_acquire);
+    if (flushTo > read) {
+        size_t skipped = 0;
+        for (uint64_t i = read; i < flushTo; ++i) {
+            skipped += src.entries[i % kQueueDepth].size;
+        }
+        skipped -= src.position;
+        src.queued.fetch_sub(skipped, std::memory_order_relaxed);
+        src.position = 0;
+        read = flushTo;
+        src.read.store(read, std::memory_order_release);
+    }
+    
+    const float gain = src.gain.load(std::memory_order_relaxed);
+    size_t mixed = 0;
+    
+    while (mixed < frames && read < write) {
+        const Entry& entry = src.entries[read % kQueueDepth];
+        size_t n = std::min(frames - mixed, entry.size - src.position);
+        const float* in = entry.data + src.position;
+        
+        for (size_t i = 0; i < n; ++i) {
+            out[mixed + i] += in[i] * gain;
+        }
+        
+        mixed += n;
+        src.position += n;
+        
+        if (src.position == entry.size) {
+            src.position = 0;
+            ++read;
+            src.read.store(read, std::memory_order_release);
+            slotsFreed = true;
+        }
+    }
+    
+    if (mixed > 0) {
+        src.queued.fetch_sub(mixed, std::memory_order_relaxed);
+    }
+    
+    return mixed;
+}
+
+} // namespace rtv::audio
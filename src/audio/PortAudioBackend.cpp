@@ -0,0 +1,351 @@
+/**
+ * PortAudioBackend.cpp - PortAudio streams under AudioEngine
+ *
+ * Owns Pa_Initialize/Pa_Terminate and the streams; all processing happens
+ * in the engine behind AudioIO.
+ */
+
+#include "rtv/audio/PortAudioBackend.hpp"
+#include "rtv/audio/AudioEngine.hpp"
+
+#include <portaudio.h>
+#include <algorithm>
+#include <iostream>
+
+namespace rtv::audio {
+
+struct PortAudioBackend::Impl {
+    PaStream* inputStream = nullptr;
+    PaStream* outputStream = nullptr;
+    PaStream* duplexStream = nullptr;
+
+    AudioIO* io = nullptr;
+    bool initialized = false;
+
+    bool openInput(const AudioConfig& config, std::string& error);
+    bool openOutput(const AudioConfig& config, std::string& error);
+    bool openDuplex(const AudioConfig& config, std::string& error);
+    void closeStreams();
+};
+
+/**
+ * Configured device, or the host default
+ */
+static PaDeviceIndex resolveDevice(int configured, bool input) {
+    if (configured >= 0) return configured;
+    return input ? Pa_GetDefaultInputDevice() : Pa_GetDefaultOutputDevice();
+}
+
+static PaStreamParameters streamParameters(PaDeviceIndex device, int channels, bool input) {
+    PaStreamParameters params;
+    params.device = device;
+    params.channelCount = channels;
+    params.sampleFormat = paFloat32;
+    params.suggestedLatency = input
+        ? Pa_GetDeviceInfo(device)->defaultLowInputLatency
+        : Pa_GetDeviceInfo(device)->defaultLowOutputLatency;
+    params.hostApiSpecificStreamInfo = nullptr;
+    return params;
+}
+
+static BlockStatus blockStatus(PaStreamCallbackFlags statusFlags) {
+    BlockStatus status;
+    status.input_overflow = statusFlags & paInputOverflow;
+    status.input_underflow = statusFlags & paInputUnderflow;
+    status.output_overflow = statusFlags & paOutputOverflow;
+    status.output_underflow = statusFlags & paOutputUnderflow;
+    return status;
+}
+
+// ============================================================================
+// PortAudio Callbacks
+// ============================================================================
+
+static int inputCallback(
+    const void* input,
+    void* output,
+    unsigned long frameCount,
+    const PaStreamCallbackTimeInfo* timeInfo,
+    PaStreamCallbackFlags statusFlags,
+    void* userData
+) {
+    auto* io = static_cast<AudioIO*>(userData);
+    io->onCapture(static_cast<const float*>(input), frameCount, blockStatus(statusFlags));
+    return paContinue;
+}
+
+static int outputCallback(
+    const void* input,
+    void* output,
+    unsigned long frameCount,
+    const PaStreamCallbackTimeInfo* timeInfo,
+    PaStreamCallbackFlags statusFlags,
+    void* userData
+) {
+    auto* io = static_cast<AudioIO*>(userData);
+    io->onRender(static_cast<float*>(output), frameCount, blockStatus(statusFlags));
+    return paContinue;
+}
+
+static int duplexCallback(
+    const void* input,
+    void* output,
+    unsigned long frameCount,
+    const PaStreamCallbackTimeInfo* timeInfo,
+    PaStreamCallbackFlags statusFlags,
+    void* userData
+) {
+    auto* io = static_cast<AudioIO*>(userData);
+
+    BlockTiming timing;
+    if (timeInfo) {
+        timing.input_adc_time = timeInfo->inputBufferAdcTime;
+        timing.output_dac_time = timeInfo->outputBufferDacTime;
+        timing.current_time = timeInfo->currentTime;
+    }
+
+    io->onDuplex(static_cast<const float*>(input), static_cast<float*>(output), frameCount,
+                 timing, blockStatus(statusFlags));
+    return paContinue;
+}
+
+// ============================================================================
+// Streams
+// ============================================================================
+
+bool PortAudioBackend::Impl::openInput(const AudioConfig& config, std::string& error) {
+    PaDeviceIndex device = resolveDevice(config.input_device, true);
+    if (device == paNoDevice) {
+        error = "No input device available";
+        return false;
+    }
+
+    PaStreamParameters inputParams = streamParameters(device, std::max(1, config.capture_channels), true);
+    PaError err = Pa_OpenStream(
+        &inputStream,
+        &inputParams,
+        nullptr,  // No output for this stream
+        config.sample_rate,
+        config.frames_per_buffer,
+        paClipOff,
+        inputCallback,
+        io
+    );
+
+    if (err != paNoError) {
+        error = std::string("Pa_OpenStream (input) failed: ") + Pa_GetErrorText(err);
+        inputStream = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool PortAudioBackend::Impl::openOutput(const AudioConfig& config, std::string& error) {
+    PaDeviceIndex device = resolveDevice(config.output_device, false);
+    if (device == paNoDevice) {
+        error = "No output device available";
+        return false;
+    }
+
+    PaStreamParameters outputParams = streamParameters(device, config.channels, false);
+    PaError err = Pa_OpenStream(
+        &outputStream,
+        nullptr,  // No input for this stream
+        &outputParams,
+        config.output_sample_rate,  // 24kHz for TTS output
+        config.frames_per_buffer,
+        paClipOff,
+        outputCallback,
+        io
+    );
+
+    if (err != paNoError) {
+        error = std::string("Pa_OpenStream (output) failed: ") + Pa_GetErrorText(err);
+        outputStream = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * A single stream carrying both capture and playback, so every block has
+ * one set of timestamps for both directions
+ */
+bool PortAudioBackend::Impl::openDuplex(const AudioConfig& config, std::string& error) {
+    PaDeviceIndex inputDevice = resolveDevice(config.input_device, true);
+    PaDeviceIndex outputDevice = resolveDevice(config.output_device, false);
+    if (inputDevice == paNoDevice || outputDevice == paNoDevice) {
+        error = "No duplex device pair available";
+        return false;
+    }
+
+    PaStreamParameters inputParams = streamParameters(inputDevice, std::max(1, config.capture_channels), true);
+    PaStreamParameters outputParams = streamParameters(outputDevice, config.channels, false);
+
+    // Both directions share the capture rate; the engine converts playback
+    PaError err = Pa_OpenStream(
+        &duplexStream,
+        &inputParams,
+        &outputParams,
+        config.sample_rate,
+        config.frames_per_buffer,
+        paClipOff,
+        duplexCallback,
+        io
+    );
+
+    if (err != paNoError) {
+        error = std::string("Pa_OpenStream (duplex) failed: ") + Pa_GetErrorText(err);
+        duplexStream = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void PortAudioBackend::Impl::closeStreams() {
+    for (PaStream** stream : {&inputStream, &outputStream, &duplexStream}) {
+        if (!*stream) continue;
+        Pa_StopStream(*stream);
+        Pa_CloseStream(*stream);
+        *stream = nullptr;
+    }
+}
+
+PortAudioBackend::PortAudioBackend()
+    : pImpl_(std::make_unique<Impl>())
+{
+}
+
+PortAudioBackend::~PortAudioBackend() {
+    close();
+
+    if (pImpl_->initialized) {
+        Pa_Terminate();
+    }
+}
+
+bool PortAudioBackend::initialize(std::string& error) {
+    if (pImpl_->initialized) {
+        return true;
+    }
+
+    PaError err = Pa_Initialize();
+    if (err != paNoError) {
+        error = std::string("Pa_Initialize failed: ") + Pa_GetErrorText(err);
+        return false;
+    }
+
+    pImpl_->initialized = true;
+
+    // Log available devices
+    int numDevices = Pa_GetDeviceCount();
+    std::cout << "[AudioEngine] Found " << numDevices << " audio devices" << std::endl;
+
+    int defaultInput = Pa_GetDefaultInputDevice();
+    int defaultOutput = Pa_GetDefaultOutputDevice();
+
+    if (defaultInput >= 0) {
+        const PaDeviceInfo* info = Pa_GetDeviceInfo(defaultInput);
+        std::cout << "[AudioEngine] Default input: " << info->name << std::endl;
+    }
+
+    if (defaultOutput >= 0) {
+        const PaDeviceInfo* info = Pa_GetDeviceInfo(defaultOutput);
+        std::cout << "[AudioEngine] Default output: " << info->name << std::endl;
+    }
+
+    return true;
+}
+
+bool PortAudioBackend::open(const AudioConfig& config, AudioIO& io, std::string& error) {
+    pImpl_->io = &io;
+
+    if (config.full_duplex) {
+        return pImpl_->openDuplex(config, error);
+    }
+
+    if (!pImpl_->openInput(config, error)) {
+        return false;
+    }
+    if (!pImpl_->openOutput(config, error)) {
+        pImpl_->closeStreams();
+        return false;
+    }
+    return true;
+}
+
+BackendLatency PortAudioBackend::latency() const {
+    BackendLatency latency;
+
+    PaStream* input = pImpl_->duplexStream ? pImpl_->duplexStream : pImpl_->inputStream;
+    PaStream* output = pImpl_->duplexStream ? pImpl_->duplexStream : pImpl_->outputStream;
+
+    if (const PaStreamInfo* info = input ? Pa_GetStreamInfo(input) : nullptr) {
+        latency.input = info->inputLatency;
+    }
+    if (const PaStreamInfo* info = output ? Pa_GetStreamInfo(output) : nullptr) {
+        latency.output = info->outputLatency;
+    }
+    return latency;
+}
+
+bool PortAudioBackend::start(std::string& error) {
+    // Input first, so the render tap never runs ahead of capture
+    for (PaStream* stream : {pImpl_->duplexStream, pImpl_->inputStream, pImpl_->outputStream}) {
+        if (!stream) continue;
+
+        PaError err = Pa_StartStream(stream);
+        if (err != paNoError) {
+            const char* which = stream == pImpl_->duplexStream ? "duplex"
+                              : stream == pImpl_->inputStream ? "input" : "output";
+            error = std::string("Pa_StartStream (") + which + ") failed: " + Pa_GetErrorText(err);
+            return false;
+        }
+    }
+    return true;
+}
+
+void PortAudioBackend::close() {
+    pImpl_->closeStreams();
+}
+
+std::string PortAudioBackend::deviceName(const AudioConfig& config, bool input) const {
+    if (Pa_Initialize() != paNoError) return "";
+
+    PaDeviceIndex device = resolveDevice(input ? config.input_device : config.output_device, input);
+    const PaDeviceInfo* info = (device != paNoDevice) ? Pa_GetDeviceInfo(device) : nullptr;
+    std::string name = info ? info->name : "";
+
+    Pa_Terminate();
+    return name;
+}
+
+static std::vector<std::string> listDevices(bool input) {
+    std::vector<std::string> devices;
+
+    PaError err = Pa_Initialize();
+    if (err != paNoError) {
+        return devices;
+    }
+
+    int numDevices = Pa_GetDeviceCount();
+    for (int i = 0; i < numDevices; ++i) {
+        const PaDeviceInfo* info = Pa_GetDeviceInfo(i);
+        if (info && (input ? info->maxInputChannels : info->maxOutputChannels) > 0) {
+            devices.push_back(info->name);
+        }
+    }
+
+    Pa_Terminate();
+    return devices;
+}
+
+std::vector<std::string> PortAudioBackend::listInputDevices() {
+    return listDevices(true);
+}
+
+std::vector<std::string> PortAudioBackend::listOutputDevices() {
+    return listDevices(false);
+}
+
+} // namespace rtv::audio
@@ -0,0 +1,52 @@
+/**
+ * PreRollBuffer.cpp - Fixed-length capture history
+ */
+
+#include "rtv/audio/PreRollBuffer.hpp"
+
+#include <algorithm>
+
+namespace rtv::audio {
+
+PreRollBuffer::PreRollBuffer(int sample_rate, int duration_ms)
+    : sample_rate_(sample_rate)
+{
+    setDuration(duration_ms);
+}
+
+void PreRollBuffer::setDuration(int duration_ms) {
+    duration_ms_ = std::max(0, duration_ms);
+    buffer_.assign(static_cast<size_t>(sample_rate_) * duration_ms_ / 1000, 0.0f);
+    clear();
+}
+
+void PreRollBuffer::write(const float* samples, size_t count) {
+    const size_t cap = buffer_.size();
+    if (cap == 0 || count == 0) return;
+    
+    // Only the newest `cap` samples can survive
+    if (count > cap) {
+        samples += count - cap;
+        count = cap;
+    }
+    
+    const size_t n1 = std::min(count, cap - next_);
+    std::copy_n(samples, n1, buffer_.begin() + next_);
+    std::copy_n(samples + n1, count - n1, buffer_.begin());
+    
+    next_ = (next_ + count) % cap;
+    size_ = std::min(size_ + count, cap);
+}
+
+void PreRollBuffer::appendTo(std::vector<float>& out) const {
+    visit([&out](const float* samples, size_t count) {
+        out.insert(out.end(), samples, samples + count);
+    });
+}
+
+void PreRollBuffer::clear() {
+    next_ = 0;
+    size_ = 0;
+}
+
+} // namespace rtv::audio
@@ -0,0 +1,111 @@
+/**
+ * Realtime.cpp - Thread priority and memory locking helpers (POSIX)
+ */
+
+#include "rtv/audio/Realtime.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace rtv::audio {
+
+namespace {
+
+// mlock() does not nest: one munlock() unlocks a page for every range on
+// it. Count the ranges holding each page and unlock only with the last.
+std::mutex pageLocksMutex;
+std::unordered_map<uintptr_t, size_t> pageLocks;
+
+size_t pageSize() {
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+} // namespace
+
+bool promoteCurrentThread(int priority, bool round_robin, std::string* error) {
+    int policy = round_robin ? SCHED_RR : SCHED_FIFO;
+    
+    sched_param param{};
+    param.sched_priority = std::clamp(
+        priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    
+    int rc = pthread_setschedparam(pthread_self(), policy, &param);
+    if (rc != 0) {
+        if (error) *error = std::strerror(rc);
+        return false;
+    }
+    return true;
+}
+
+void demoteCurrentThread() {
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+}
+
+bool lockMemory(const void* addr, size_t bytes) {
+    if (!addr || bytes == 0) return true;
+    
+    const uintptr_t page = pageSize();
+    const uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + bytes + page - 1) & ~(page - 1);
+    
+    std::lock_guard<std::mutex> lock(pageLocksMutex);
+    if (mlock(reinterpret_cast<const void*>(first), end - first) != 0) {
+        return false;
+    }
+    for (uintptr_t p = first; p < end; p += page) {
+        ++pageLocks[p];
+    }
+    return true;
+}
+
+void unlockMemory(const void* addr, size_t bytes) {
+    if (!addr || bytes == 0) return;
+    
+    const uintptr_t page = pageSize();
+    const uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + bytes + page - 1) & ~(page - 1);
+    
+    std::lock_guard<std::mutex> lock(pageLocksMutex);
+    
+    // Unlock runs of pages no other range still holds
+    uintptr_t run = end;
+    for (uintptr_t p = first; p < end; p += page) {
+        auto it = pageLocks.find(p);
+        bool release = (it != pageLocks.end() && --it->second == 0);
+        if (release) {
+            pageLocks.erase(it);
+            if (run == end) run = p;
+            continue;
+        }
+        if (run != end) {
+            munlock(reinterpret_cast<const void*>(run), p - run);
+            run = end;
+        }
+    }
+    if (run != end) {
+        munlock(reinterpret_cast<const void*>(run), end - run);
+    }
+}
+
+void prefaultMemory(void* addr, size_t bytes) {
+    if (!addr || bytes == 0) return;
+    
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    volatile char* p = static_cast<volatile char*>(addr);
+    for (size_t offset = 0; offset < bytes; offset += page) {
+        p[offset] = p[offset];
+    }
+    p[bytes - 1] = p[bytes - 1];
+}
+
+} // namespace rtv::audio
@@ -0,0 +1,250 @@
+/**
+ * Resampler.cpp - Polyphase windowed-sinc sample rate converter
+ *
+ * The prototype low-pass runs at L * input_rate and is split into L phases.
+ * Each output sample picks one phase and takes a dot product against the
+ * newest input samples, so the cost per output is taps-per-phase multiplies
+ * regardless of how large L and M are.
+ */
+
+#include "rtv/audio/Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define RTV_RESAMPLER_AVX2 1
+#endif
+
+namespace rtv::audio {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kKaiserBeta = 8.0;   // ~80 dB stopband
+constexpr double kRolloff = 0.85;     // Cutoff as a fraction of the lower Nyquist
+constexpr size_t kTapAlign = 8;       // One AVX register of floats
+constexpr size_t kBlock = 1024;       // Input samples buffered per inner pass
+
+/**
+ * Zeroth-order modified Bessel function (series expansion)
+ */
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double q = x * x / 4.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+/**
+ * Dot product of n floats; n is a multiple of kTapAlign
+ */
+inline float dot(const float* a, const float* b, size_t n) {
+#ifdef RTV_RESAMPLER_AVX2
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    if (i < n) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x1));
+    return _mm_cvtss_f32(sum);
+#else
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+#endif
+}
+
+} // namespace
+
+struct Resampler::Impl {
+    int inputRate;
+    int outputRate;
+    size_t L = 1;  // Interpolation factor
+    size_t M = 1;  // Decimation factor
+    size_t taps = 0;
+
+    // L phases of `taps` coefficients, time-reversed so each output is a
+    // forward dot product over history
+    std::vector<float> coeffs;
+
+    // Last taps-1 inputs followed by up to kBlock new ones
+    std::vector<float> history;
+    size_t filled = 0;
+    size_t index = 0;   // History slot of the newest input the next output uses
+    size_t phase = 0;   // Next output's phase within that input
+
+    Impl(int in, int out, int tapsPerPhase) : inputRate(in), outputRate(out) {
+        if (in <= 0 || out <= 0 || tapsPerPhase <= 0) {
+            throw std::invalid_argument("Resampler: rates and taps must be positive");
+        }
+        if (in == out) return;
+
+        size_t g = std::gcd(static_cast<size_t>(in), static_cast<size_t>(out));
+        L = static_cast<size_t>(out) / g;
+        M = static_cast<size_t>(in) / g;
+
+        // Keep the transition band constant relative to the lower rate
+        double scale = std::max(1.0, static_cast<double>(M) / L);
+        taps = static_cast<size_t>(std::ceil(tapsPerPhase * scale));
+        taps = (taps + kTapAlign - 1) / kTapAlign * kTapAlign;
+
+        design();
+        history.assign(taps - 1 + kBlock, 0.0f);
+        resetState();
+    }
+
+    void design() {
+        // Centre on an integer tap so the delay is a whole number of inputs
+        const size_t N = L * taps;
+        const double center = N / 2.0;
+        const double fc = 0.5 * kRolloff * std::min(1.0, static_cast<double>(L) / M) / L;
+        const double norm = besselI0(kKaiserBeta);
+
+        std::vector<double> h(N);
+        for (size_t q = 0; q < N; ++q) {
+            double t = q - center;
+            double x = 2.0 * fc * t;
+            double sinc = (t == 0.0) ? 1.0 : std::sin(kPi * x) / (kPi * x);
+            double r = t / center;
+            double w = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+            h[q] = 2.0 * fc * sinc * w;
+        }
+
+        // Unity DC gain per phase, so a constant input gives a constant output
+        coeffs.assign(L * taps, 0.0f);
+        for (size_t p = 0; p < L; ++p) {
+            double sum = 0.0;
+            for (size_t k = 0; k < taps; ++k) sum += h[p + k * L];
+            double gain = (sum != 0.0) ? 1.0 / sum : 0.0;
+            for (size_t k = 0; k < taps; ++k) {
+                coeffs[p * taps + (taps - 1 - k)] = static_cast<float>(h[p + k * L] * gain);
+            }
+        }
+    }
+
+    void resetState() {
+        std::fill(history.begin(), history.end(), 0.0f);
+        filled = taps - 1;
+        index = taps - 1;
+        phase = 0;
+    }
+
+    /**
+     * Start the first output at the filter centre instead of its first tap,
+     * so output k lines up exactly with input time k * M / L
+     */
+    void skipDelay() {
+        index += taps / 2;
+    }
+
+    size_t process(const float* input, size_t count, float* output) {
+        if (L == M) {
+            std::memcpy(output, input, count * sizeof(float));
+            return count;
+        }
+
+        size_t produced = 0;
+        while (count > 0) {
+            size_t n = std::min(count, kBlock);
+            std::memcpy(history.data() + filled, input, n * sizeof(float));
+            filled += n;
+            input += n;
+            count -= n;
+
+            while (index < filled) {
+                output[produced++] = dot(coeffs.data() + phase * taps,
+                                         history.data() + index + 1 - taps, taps);
+                phase += M;
+                index += phase / L;
+                phase %= L;
+            }
+
+            // index is now past the block; keep only the taps-1 history it needs
+            size_t drop = filled - (taps - 1);
+            std::memmove(history.data(), history.data() + drop, (taps - 1) * sizeof(float));
+            filled -= drop;
+            index -= drop;
+        }
+        return produced;
+    }
+};
+
+Resampler::Resampler(int input_rate, int output_rate, int taps_per_phase)
+    : impl_(std::make_unique<Impl>(input_rate, output_rate, taps_per_phase)) {}
+
+Resampler::~Resampler() = default;
+
+Resampler::Resampler(Resampler&&) noexcept = default;
+Resampler& Resampler::operator=(Resampler&&) noexcept = default;
+
+int Resampler::inputRate() const { return impl_->inputRate; }
+int Resampler::outputRate() const { return impl_->outputRate; }
+bool Resampler::isPassthrough() const { return impl_->L == impl_->M; }
+
+size_t Resampler::maxOutput(size_t count) const {
+    if (isPassthrough()) return count;
+    return count * impl_->L / impl_->M + 2;
+}
+
+double Resampler::delay() const {
+    if (isPassthrough()) return 0.0;
+    return static_cast<double>(impl_->L * impl_->taps) / 2.0 / impl_->M;
+}
+
+size_t Resampler::process(const float* input, size_t count, float* output) {
+    return impl_->process(input, count, output);
+}
+
+std::vector<float> Resampler::process(const std::vector<float>& input) {
+    std::vector<float> output(maxOutput(input.size()));
+    output.resize(process(input.data(), input.size(), output.data()));
+    return output;
+}
+
+void Resampler::reset() {
+    if (!isPassthrough()) impl_->resetState();
+}
+
+std::vector<float> Resampler::convert(const std::vector<float>& input,
+                                      int input_rate, int output_rate) {
+    if (input_rate == output_rate || input.empty()) return input;
+
+    Resampler resampler(input_rate, output_rate);
+    resampler.impl_->skipDelay();
+
+    const size_t length = static_cast<size_t>(std::lround(
+        static_cast<double>(input.size()) * output_rate / input_rate));
+    const size_t tail = resampler.impl_->taps / 2 + 1;
+
+    std::vector<float> output(resampler.maxOutput(input.size()) + resampler.maxOutput(tail));
+    size_t produced = resampler.process(input.data(), input.size(), output.data());
+
+    // Push zeros through so the last inputs reach the filter centre
+    std::vector<float> zeros(tail, 0.0f);
+    produced += resampler.process(zeros.data(), zeros.size(), output.data() + produced);
+
+    output.resize(std::min(produced, length));
+    return output;
+}
+
+} // namespace rtv::audio
@@ -1,12 +1,58 @@
 /**
  * RingBuffer.cpp - Lock-free SPSC implementation
- * Note: Most logic is in header (template class)
+ * Note: Most logic is in header (template class); this file holds the
+ * platform wait primitives behind wait_for_data()/wait_for_space().
  */
 
 #include "rtv/audio/RingBuffer.hpp"
 
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 namespace rtv::audio {
 
+namespace detail {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+void waitOnAddress(std::atomic<uint32_t>& word, uint32_t expected,
+                   std::chrono::nanoseconds timeout) {
+    if (timeout <= std::chrono::nanoseconds::zero()) return;
+#ifdef __linux__
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(secs.count());
+    ts.tv_nsec = static_cast<long>((timeout - secs).count());
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, &ts, nullptr, 0);
+#else
+    // No futex: short sleeps bound the added latency
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+            timeout, std::chrono::milliseconds(1)));
+    }
+#endif
+}
+
+void wakeAddress(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+} // namespace detail
+
 // Explicit instantiation for common types
 template class RingBuffer<float>;
 template class RingBuffer<int16_t>;
@@ -6,6 +6,12 @@
  */
 
 #include "rtv/audio/VADProcessor.hpp"
+#include "rtv/audio/Endpointer.hpp"
+#include "rtv/audio/EnergyGate.hpp"
+#include "rtv/audio/FrameAssembler.hpp"
+#include "rtv/audio/PreRollBuffer.hpp"
+#include "rtv/audio/RingBuffer.hpp"
+#include "rtv/audio/SampleConvert.hpp"
 
 #include <fvad.h>
 #include <iostream>
@@ -21,26 +27,107 @@ struct VADProcessor::Impl {
     int frame_ms;
     int frame_samples;  // Samples per frame
     
-    // Frame accumulation
-    std::vector<float> frameBuffer;
+    // Frame accumulation (whole frames are read straight from the input)
+    FrameAssembler frames{0};
+    std::vector<int16_t> frame16;  // libfvad input, one frame
     
-    // Speech segment accumulation
+    // Speech segment accumulation (whole segment only for SpeechCallback)
     std::vector<float> speechBuffer;
     bool inSpeech = false;
-    int silenceFrames = 0;
+    size_t segmentSamples = 0;  // Segment length so far, pre-roll included
+    
+    // Audio from before the first speech frame, prepended to each segment
+    PreRollBuffer preRoll{16000, 0};  // Sized in the constructor
+    size_t segmentPreRoll = 0;  // Pre-roll samples at the start of the segment
+    
+    // Streaming mode: the segment passes through a ring one chunk deep
+    SpeechEventCallback eventCallback;
+    std::unique_ptr<RingBuffer<float>> segmentRing;
+    size_t chunkSamples = 0;
+    size_t streamedSamples = 0;  // Segment samples already sent as chunks
+    
+    // Decides when trailing silence ends the turn
+    Endpointer endpointer;
+    
+    // Optional level pre-gate: skips libfvad on frames far below speech level
+    std::unique_ptr<EnergyGate> gate;
     
     // Configuration
-    int silenceTimeoutMs = 500;
     int minSpeechDurationMs = 200;
-    int silenceTimeoutFrames;
     int minSpeechFrames;
     
     SpeechCallback callback;
     
     void updateThresholds() {
-        silenceTimeoutFrames = silenceTimeoutMs / frame_ms;
         minSpeechFrames = minSpeechDurationMs / frame_ms;
     }
+    
+    int durationMs(size_t samples) const {
+        return static_cast<int>(samples * 1000 / sample_rate);
+    }
+    
+    void emit(SpeechEventType type, size_t count, bool accepted = false) {
+        SpeechEvent event;
+        event.type = type;
+        event.audio = segmentRing->peek_read(count);
+        event.offset = streamedSamples;
+        event.duration_ms = durationMs(streamedSamples + event.audio.size());
+        event.accepted = accepted;
+        if (type == SpeechEventType::End && accepted) {
+            event.endpoint_delay_ms = endpointer.lastEndpoint().delay_ms;
+        }
+        eventCallback(event);
+        
+        streamedSamples += event.audio.size();
+        segmentRing->consume(event.audio.size());
+    }
+    
+    void beginSegment() {
+        segmentSamples = 0;
+        streamedSamples = 0;
+        if (eventCallback) {
+            segmentRing->clear();
+            emit(SpeechEventType::Start, 0);
+        }
+        
+        // Begin with the audio that led up to it
+        segmentPreRoll = preRoll.size();
+        preRoll.visit([this](const float* samples, size_t count) { append(samples, count); });
+        preRoll.clear();
+    }
+    
+    void append(const float* samples, size_t count) {
+        segmentSamples += count;
+        if (callback) {
+            speechBuffer.insert(speechBuffer.end(), samples, samples + count);
+        }
+        if (!eventCallback) return;
+        
+        // The ring holds at least one chunk, so every pass makes progress
+        while (count > 0) {
+            size_t written = segmentRing->push(samples, count);
+            samples += written;
+            count -= written;
+            while (segmentRing->available() >= chunkSamples) {
+                emit(SpeechEventType::Chunk, chunkSamples);
+            }
+        }
+    }
+    
+    void endSegment(bool accepted) {
+        if (accepted && callback) {
+            callback(speechBuffer, durationMs(speechBuffer.size()));
+        }
+        if (eventCallback) {
+            emit(SpeechEventType::End, segmentRing->available(), accepted);
+        }
+        
+        // Reset state
+        speechBuffer.clear();
+        segmentSamples = 0;
+        segmentPreRoll = 0;
+        inSpeech = false;
+    }
 };
 
 VADProcessor::VADProcessor(int sample_rate, VADMode mode, int frame_ms)
@@ -50,8 +137,9 @@ VADProcessor::VADProcessor(int sample_rate, VADMode mode, int frame_ms)
     pImpl_->frame_ms = frame_ms;
     pImpl_->frame_samples = (sample_rate * frame_ms) / 1000;
     
-    pImpl_->frameBuffer.reserve(pImpl_->frame_samples);
-    pImpl_->speechBuffer.reserve(sample_rate * 30);  // 30 seconds max
+    pImpl_->frames = FrameAssembler(pImpl_->frame_samples);
+    pImpl_->frame16.assign(pImpl_->frame_samples, 0);
+    pImpl_->preRoll = PreRollBuffer(sample_rate, 300);  // 300ms default
     
     pImpl_->updateThresholds();
     
@@ -87,79 +175,108 @@ VADProcessor::~VADProcessor() {
 void VADProcessor::process(const float* samples, size_t count) {
     if (!pImpl_->vad) return;
     
-    // Accumulate samples into frame buffer
-    for (size_t i = 0; i < count; ++i) {
-        pImpl_->frameBuffer.push_back(samples[i]);
-        
-        // Process complete frame
-        if (pImpl_->frameBuffer.size() >= static_cast<size_t>(pImpl_->frame_samples)) {
-            processFrame();
-        }
-    }
+    pImpl_->frames.push(samples, count, [this](const float* frame) {
+        processFrame(frame);
+    });
 }
 
-void VADProcessor::processFrame() {
-    if (!pImpl_->vad) return;
+void VADProcessor::processFrame(const float* frame) {
+    const size_t frameSize = static_cast<size_t>(pImpl_->frame_samples);
     
     // Convert float to int16 for libfvad
-    std::vector<int16_t> frame16(pImpl_->frame_samples);
-    for (int i = 0; i < pImpl_->frame_samples; ++i) {
-        float sample = std::clamp(pImpl_->frameBuffer[i], -1.0f, 1.0f);
-        frame16[i] = static_cast<int16_t>(sample * 32767.0f);
-    }
+    floatToInt16(frame, pImpl_->frame16.data(), frameSize);
     
-    // Run VAD
-    int result = fvad_process(pImpl_->vad, frame16.data(), pImpl_->frame_samples);
-    bool isSpeech = (result == 1);
+    // Run VAD. Outside speech the gate may skip the frame; inside a segment
+    // every frame is classified so the endpointer sees the trailing silence
+    bool isSpeech = false;
+    auto classify = [&](const int16_t* frame16) {
+        isSpeech = fvad_process(pImpl_->vad, frame16, frameSize) == 1;
+    };
+    if (pImpl_->gate && !pImpl_->inSpeech) {
+        // Replayed lookback frames only warm up fvad; their audio is already
+        // in the pre-roll. The last call is this frame.
+        pImpl_->gate->process(pImpl_->frame16.data(), classify);
+    } else {
+        classify(pImpl_->frame16.data());
+    }
+    bool endOfTurn = pImpl_->endpointer.update(isSpeech, pImpl_->frame_ms);
     
     if (isSpeech) {
-        // Add frame to speech buffer
-        pImpl_->speechBuffer.insert(
-            pImpl_->speechBuffer.end(),
-            pImpl_->frameBuffer.begin(),
-            pImpl_->frameBuffer.end()
-        );
+        if (!pImpl_->inSpeech) {
+            pImpl_->beginSegment();
+        }
+        
+        // Add frame to the segment
+        pImpl_->append(frame, frameSize);
         
         pImpl_->inSpeech = true;
-        pImpl_->silenceFrames = 0;
     } else if (pImpl_->inSpeech) {
         // Still add frame (might be brief pause)
-        pImpl_->speechBuffer.insert(
-            pImpl_->speechBuffer.end(),
-            pImpl_->frameBuffer.begin(),
-            pImpl_->frameBuffer.end()
-        );
-        
-        pImpl_->silenceFrames++;
+        pImpl_->append(frame, frameSize);
         
         // Check for end of speech
-        if (pImpl_->silenceFrames >= pImpl_->silenceTimeoutFrames) {
-            // Calculate speech duration
-            int speechFrames = static_cast<int>(pImpl_->speechBuffer.size()) / pImpl_->frame_samples;
-            
-            // Trigger callback if long enough
-            if (speechFrames >= pImpl_->minSpeechFrames && pImpl_->callback) {
-                int duration_ms = static_cast<int>(pImpl_->speechBuffer.size()) * 1000 / pImpl_->sample_rate;
-                pImpl_->callback(pImpl_->speechBuffer, duration_ms);
-            }
+        if (endOfTurn) {
+            // Calculate speech duration (pre-roll does not count towards the minimum)
+            int speechFrames = static_cast<int>(pImpl_->segmentSamples - pImpl_->segmentPreRoll)
+                             / pImpl_->frame_samples;
             
-            // Reset state
-            pImpl_->speechBuffer.clear();
-            pImpl_->inSpeech = false;
-            pImpl_->silenceFrames = 0;
+            // Deliver if long enough; blips that are not stay out of the turn statistics
+            bool accepted = speechFrames >= pImpl_->minSpeechFrames;
+            pImpl_->endpointer.commitTurn(accepted);
+            pImpl_->endSegment(accepted);
         }
+    } else {
+        pImpl_->preRoll.write(frame, frameSize);
     }
-    
-    pImpl_->frameBuffer.clear();
 }
 
 void VADProcessor::setSpeechCallback(SpeechCallback callback) {
     pImpl_->callback = std::move(callback);
+    if (pImpl_->callback) {
+        pImpl_->speechBuffer.reserve(pImpl_->sample_rate * 30);  // 30 seconds max
+    }
+}
+
+void VADProcessor::setSpeechEventCallback(SpeechEventCallback callback, int chunk_ms) {
+    Impl& impl = *pImpl_;
+    impl.eventCallback = std::move(callback);
+    if (!impl.eventCallback) {
+        impl.segmentRing.reset();
+        return;
+    }
+    
+    // Whole frames per chunk; one extra frame of room so a frame never waits
+    int frames_per_chunk = std::max(1, chunk_ms / impl.frame_ms);
+    impl.chunkSamples = static_cast<size_t>(frames_per_chunk) * impl.frame_samples;
+    impl.segmentRing = std::make_unique<RingBuffer<float>>(impl.chunkSamples + impl.frame_samples);
+    impl.streamedSamples = 0;
 }
 
 void VADProcessor::setSilenceTimeout(int timeout_ms) {
-    pImpl_->silenceTimeoutMs = timeout_ms;
-    pImpl_->updateThresholds();
+    // The endpointer adapts below this; it never waits longer
+    EndpointerConfig config = pImpl_->endpointer.config();
+    config.max_timeout_ms = timeout_ms;
+    pImpl_->endpointer.setConfig(config);
+}
+
+void VADProcessor::setPartialTranscript(const std::string& text) {
+    pImpl_->endpointer.setPartialTranscript(text);
+}
+
+Endpointer& VADProcessor::endpointer() {
+    return pImpl_->endpointer;
+}
+
+void VADProcessor::setEnergyGate(bool enabled, const EnergyGateConfig& config) {
+    if (enabled) {
+        pImpl_->gate = std::make_unique<EnergyGate>(pImpl_->frame_samples, pImpl_->sample_rate, config);
+    } else {
+        pImpl_->gate.reset();
+    }
+}
+
+EnergyGateStats VADProcessor::gateStats() const {
+    return pImpl_->gate ? pImpl_->gate->stats() : EnergyGateStats();
 }
 
 void VADProcessor::setMinSpeechDuration(int min_ms) {
@@ -167,19 +284,29 @@ void VADProcessor::setMinSpeechDuration(int min_ms) {
     pImpl_->updateThresholds();
 }
 
+void VADProcessor::setPreRoll(int duration_ms) {
+    pImpl_->preRoll.setDuration(duration_ms);
+}
+
 bool VADProcessor::isSpeaking() const {
     return pImpl_->inSpeech;
 }
 
 int VADProcessor::currentSpeechDuration() const {
-    return static_cast<int>(pImpl_->speechBuffer.size()) * 1000 / pImpl_->sample_rate;
+    return pImpl_->durationMs(pImpl_->segmentSamples);
 }
 
 void VADProcessor::reset() {
-    pImpl_->frameBuffer.clear();
-    pImpl_->speechBuffer.clear();
-    pImpl_->inSpeech = false;
-    pImpl_->silenceFrames = 0;
+    // A streaming consumer is told the open segment is abandoned
+    if (pImpl_->inSpeech) {
+        pImpl_->endSegment(false);
+    }
+    pImpl_->frames.clear();
+    pImpl_->preRoll.clear();
+    pImpl_->endpointer.reset();
+    if (pImpl_->gate) {
+        pImpl_->gate->reset();
+    }
     
     if (pImpl_->vad) {
         fvad_reset(pImpl_->vad);
@@ -0,0 +1,202 @@
+/**
+ * WavFile.cpp - Minimal RIFF/WAVE reader and streaming writer
+ */
+
+#include "rtv/audio/WavFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rtv::audio {
+
+namespace {
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24));
+}
+
+void writeU16(std::ofstream& f, uint16_t v) {
+    uint8_t b[2] = {static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8)};
+    f.write(reinterpret_cast<const char*>(b), 2);
+}
+
+void writeU32(std::ofstream& f, uint32_t v) {
+    uint8_t b[4] = {
+        static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+        static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24)
+    };
+    f.write(reinterpret_cast<const char*>(b), 4);
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+constexpr uint16_t WAVE_FORMAT_PCM = 1;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+} // anonymous namespace
+
+bool readWav(const std::string& path, WavData& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        return fail(error, "cannot open " + path);
+    }
+    
+    size_t file_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::vector<uint8_t> data(file_size);
+    file.read(reinterpret_cast<char*>(data.data()), file_size);
+    
+    if (file_size < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 ||
+        std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        return fail(error, "not a RIFF/WAVE file: " + path);
+    }
+    
+    uint16_t format = 0;
+    uint16_t channels = 0;
+    uint32_t sample_rate = 0;
+    uint16_t bits = 0;
+    const uint8_t* pcm = nullptr;
+    size_t pcm_bytes = 0;
+    
+    // Walk chunks; sizes are padded to even byte counts
+    size_t pos = 12;
+    while (pos + 8 <= file_size) {
+        const uint8_t* chunk = data.data() + pos;
+        uint32_t chunk_size = readU32(chunk + 4);
+        size_t body = pos + 8;
+        size_t body_size = std::min<size_t>(chunk_size, file_size - body);
+        
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && body_size >= 16) {
+            format = readU16(data.data() + body);
+            channels = readU16(data.data() + body + 2);
+            sample_rate = readU32(data.data() + body + 4);
+            bits = readU16(data.data() + body + 14);
+            if (format == WAVE_FORMAT_EXTENSIBLE && body_size >= 26) {
+                format = readU16(data.data() + body + 24);  // SubFormat GUID prefix
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            pcm = data.data() + body;
+            pcm_bytes = body_size;
+        }
+        
+        pos = body + chunk_size + (chunk_size & 1);
+    }
+    
+    if (channels == 0 || sample_rate == 0 || !pcm) {
+        return fail(error, "missing fmt or data chunk: " + path);
+    }
+    
+    out.sample_rate = static_cast<int>(sample_rate);
+    out.channels = channels;
+    out.samples.clear();
+    
+    if (format == WAVE_FORMAT_IEEE_FLOAT && bits == 32) {
+        size_t n = pcm_bytes / 4;
+        out.samples.resize(n);
+        std::memcpy(out.samples.data(), pcm, n * sizeof(float));
+    } else if (format == WAVE_FORMAT_PCM && bits == 16) {
+        size_t n = pcm_bytes / 2;
+        out.samples.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            out.samples[i] = static_cast<int16_t>(readU16(pcm + i * 2)) / 32768.0f;
+        }
+    } else if (format == WAVE_FORMAT_PCM && bits == 24) {
+        size_t n = pcm_bytes / 3;
+        out.samples.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const uint8_t* p = pcm + i * 3;
+            int32_t val = (p[0] << 8) | (p[1] << 16) | (p[2] << 24);
+            out.samples[i] = (val >> 8) / 8388608.0f;
+        }
+    } else if (format == WAVE_FORMAT_PCM && bits == 32) {
+        size_t n = pcm_bytes / 4;
+        out.samples.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            out.samples[i] = static_cast<int32_t>(readU32(pcm + i * 4)) / 2147483648.0f;
+        }
+    } else {
+        return fail(error, "unsupported WAV format " + std::to_string(format) +
+                           " with " + std::to_string(bits) + " bits: " + path);
+    }
+    
+    return true;
+}
+
+std::vector<float> downmixToMono(const WavData& wav) {
+    if (wav.channels <= 1) {
+        return wav.samples;
+    }
+    
+    size_t frames = wav.frames();
+    std::vector<float> mono(frames);
+    const float scale = 1.0f / wav.channels;
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (int c = 0; c < wav.channels; ++c) {
+            sum += wav.samples[i * wav.channels + c];
+        }
+        mono[i] = sum * scale;
+    }
+    return mono;
+}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::open(const std::string& path, int sample_rate, int channels) {
+    close();
+    
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.good()) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    samples_written_ = 0;
+    
+    // Header with placeholder sizes, patched in close()
+    file_.write("RIFF", 4);
+    writeU32(file_, 0);
+    file_.write("WAVE", 4);
+    file_.write("fmt ", 4);
+    writeU32(file_, 16);
+    writeU16(file_, WAVE_FORMAT_IEEE_FLOAT);
+    writeU16(file_, static_cast<uint16_t>(channels_));
+    writeU32(file_, static_cast<uint32_t>(sample_rate_));
+    writeU32(file_, static_cast<uint32_t>(sample_rate_ * channels_ * sizeof(float)));
+    writeU16(file_, static_cast<uint16_t>(channels_ * sizeof(float)));
+    writeU16(file_, 32);
+    file_.write("data", 4);
+    writeU32(file_, 0);
+    
+    return file_.good();
+}
+
+void WavWriter::write(const float* samples, size_t count) {
+    if (!file_.is_open() || count == 0) return;
+    file_.write(reinterpret_cast<const char*>(samples), count * sizeof(float));
+    samples_written_ += count;
+}
+
+void WavWriter::close() {
+    if (!file_.is_open()) return;
+    
+    uint32_t data_bytes = static_cast<uint32_t>(samples_written_ * sizeof(float));
+    file_.seekp(4);
+    writeU32(file_, 36 + data_bytes);
+    file_.seekp(40);
+    writeU32(file_, data_bytes);
+    file_.close();
+}
+
+} // namespace rtv::audio
@@ -6,7 +6,14 @@
 
 #include "rtv/Orchestrator.hpp"
 #include "rtv/audio/AudioEngine.hpp"
+#include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/DelayCalibrator.hpp"
+#include "rtv/audio/Endpointer.hpp"
+#include "rtv/audio/EnergyGate.hpp"
+#include "rtv/audio/PlaybackMixer.hpp"
+#include "rtv/audio/Resampler.hpp"
 #include "rtv/audio/VADProcessor.hpp"
+#include "rtv/audio/WavFile.hpp"
 #include "rtv/stt/STTEngine.hpp"
 #include "rtv/llm/ConversationEngine.hpp"
 #include "rtv/tts/TTSEngine.hpp"
@@ -16,7 +23,9 @@
 #include "rtv/wakeword/WakeWordDetector.hpp"
 #endif
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -29,6 +38,8 @@ namespace rtv {
 struct Orchestrator::Impl {
     // Components
     std::unique_ptr<audio::AudioEngine> audio;
+    std::unique_ptr<audio::AudioPipeline> aec;
+    int output_sample_rate = 24000;  // Playback stream rate
     std::unique_ptr<audio::VADProcessor> vad;
     std::unique_ptr<stt::STTEngine> stt;
     std::unique_ptr<llm::ConversationEngine> llm;
@@ -45,10 +56,22 @@ struct Orchestrator::Impl {
     std::atomic<OrchestratorState> state{OrchestratorState::SLEEPING};
     std::thread worker_thread;
     
+    // Run-loop wake-ups: bumped on state changes, speech end, queued TTS audio
+    // and interrupts, so the loop reacts immediately instead of on a timer
+    std::mutex event_mutex;
+    std::condition_variable event_cv;
+    uint64_t event_seq = 0;
+    uint64_t handled_seq = 0;
+    
     // Audio buffer for recording
     std::vector<float> audio_buffer;
     std::mutex buffer_mutex;
     bool speech_active = false;
+    size_t segment_start = 0;  // audio_buffer size when the current segment began
+    
+    // Set on entering SPEAKING; the capture thread, which owns the VAD,
+    // resets it once on its next block
+    std::atomic<bool> vad_reset_pending{false};
     
     // Wake word state
     bool awaiting_command = false;  // True after wake word, waiting for user command
@@ -63,108 +86,79 @@ struct Orchestrator::Impl {
     std::string tts_ref_voice = "models/tts/reference_voice.wav";
     std::string llm_url = "http://localhost:8080";
     std::string porcupine_key_file = ".porcupine_key";
+    std::string aec_delay_file = ".aec_delay.json";  // Measured AEC3 delay per device pair
+    int capture_channels = 1;  // 4 on the conference-room mic arrays
     std::string porcupine_model = "external/porcupine/lib/common/porcupine_params.pv";
     std::vector<std::string> wakeword_models = {"models/wakeword/hi_gemma.ppn"};
     
     // Pre-recorded greeting WAV for instant response
     std::string greeting_wav = "models/greetings/greeting_1.wav";
-    std::vector<float> cached_greeting;  // Loaded on init
+    audio::AudioClip cached_greeting;  // Loaded on init, played without copying
     
     // Notification sounds (optional)
     std::string wake_sound_wav = "models/sounds/wake.wav";
     std::string sleep_sound_wav = "models/sounds/sleep.wav";
-    std::vector<float> cached_wake_sound;
-    std::vector<float> cached_sleep_sound;
+    audio::AudioClip cached_wake_sound;
+    audio::AudioClip cached_sleep_sound;
+    
+    static bool hasAudio(const audio::AudioClip& clip) {
+        return clip && !clip->empty();
+    }
     
     void setState(OrchestratorState new_state) {
-        state = new_state;
+        OrchestratorState old_state = state.exchange(new_state);
+        if (new_state == OrchestratorState::SPEAKING && old_state != OrchestratorState::SPEAKING) {
+            vad_reset_pending = true;
+        }
         if (callbacks.onStateChange) {
             callbacks.onStateChange(new_state);
         }
+        notifyEvent();
     }
     
-    // Helper to load WAV file into float vector (resampled to 24000Hz)
-    std::vector<float> loadWavFile(const std::string& path) {
-        std::vector<float> samples;
-        std::ifstream wav_file(path, std::ios::binary);
-        if (!wav_file.good()) return samples;
-        
-        wav_file.seekg(0, std::ios::end);
-        size_t file_size = wav_file.tellg();
-        wav_file.seekg(0, std::ios::beg);
-        
-        if (file_size <= 44) return samples;
-        
-        std::vector<uint8_t> wav_data(file_size);
-        wav_file.read(reinterpret_cast<char*>(wav_data.data()), file_size);
-        
-        // Read WAV header
-        uint32_t sample_rate = *reinterpret_cast<uint32_t*>(&wav_data[24]);
-        uint16_t bits = *reinterpret_cast<uint16_t*>(&wav_data[34]);
-        size_t data_offset = 44;
-        
-        // Find data chunk
-        for (size_t i = 12; i < file_size - 8; i++) {
-            if (wav_data[i] == 'd' && wav_data[i+1] == 'a' && 
-                wav_data[i+2] == 't' && wav_data[i+3] == 'a') {
-                data_offset = i + 8;
-                break;
-            }
+    void notifyEvent() {
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+            ++event_seq;
+        }
+        event_cv.notify_one();
+    }
+    
+    // Returns early on any event since the previous call, so nothing
+    // signalled while the loop was busy is missed
+    void waitForEvent(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(event_mutex);
+        event_cv.wait_for(lock, timeout, [this]() {
+            return event_seq != handled_seq || !running;
+        });
+        handled_seq = event_seq;
+    }
+    
+    // Notification sounds are mastered quiet; boosted (and clamped) on load
+    static constexpr float NOTIFICATION_GAIN = 4.0f;
+    
+    // Helper to load WAV file into float vector (mono, resampled to the playback rate)
+    std::vector<float> loadWavFile(const std::string& path, float gain = 1.0f) {
+        audio::WavData wav;
+        std::string error;
+        if (!audio::readWav(path, wav, &error)) {
+            std::cerr << "[WAV] " << error << std::endl;
+            return {};
         }
         
-        if (bits == 32) {
-            size_t num_samples = (file_size - data_offset) / 4;
-            samples.resize(num_samples);
-            float* src = reinterpret_cast<float*>(&wav_data[data_offset]);
-            std::copy(src, src + num_samples, samples.begin());
-        } else if (bits == 24) {
-            // 24-bit audio: 3 bytes per sample
-            size_t num_samples = (file_size - data_offset) / 3;
-            samples.resize(num_samples);
-            const float gain = 4.0f;  // Boost volume for notification sounds
-            for (size_t i = 0; i < num_samples; i++) {
-                // Read 3 bytes, sign-extend to 32-bit
-                uint8_t* ptr = &wav_data[data_offset + i * 3];
-                int32_t val = (ptr[0] << 8) | (ptr[1] << 16) | (ptr[2] << 24);
-                val >>= 8;  // Sign-extend
-                float sample = (static_cast<float>(val) / 8388608.0f) * gain;
-                // Clamp to avoid clipping
-                samples[i] = std::max(-1.0f, std::min(1.0f, sample));
-            }
-        } else if (bits == 16) {
-            size_t num_samples = (file_size - data_offset) / 2;
-            samples.resize(num_samples);
-            int16_t* src = reinterpret_cast<int16_t*>(&wav_data[data_offset]);
-            for (size_t i = 0; i < num_samples; i++) {
-                samples[i] = static_cast<float>(src[i]) / 32768.0f;
+        std::vector<float> samples = audio::downmixToMono(wav);
+        
+        if (gain != 1.0f) {
+            for (float& sample : samples) {
+                sample = std::clamp(sample * gain, -1.0f, 1.0f);
             }
-        } else {
-            std::cerr << "[WAV] Unsupported bits per sample: " << bits << " in " << path << std::endl;
         }
         
-        // Resample to 24000Hz if needed
-        const uint32_t target_rate = 24000;
-        if (!samples.empty() && sample_rate != target_rate) {
-            std::cout << "[WAV] Resampling from " << sample_rate << "Hz to " << target_rate << "Hz" << std::endl;
-            
-            double ratio = static_cast<double>(target_rate) / sample_rate;
-            size_t new_size = static_cast<size_t>(samples.size() * ratio);
-            std::vector<float> resampled(new_size);
-            
-            for (size_t i = 0; i < new_size; i++) {
-                double src_pos = i / ratio;
-                size_t idx = static_cast<size_t>(src_pos);
-                double frac = src_pos - idx;
-                
-                if (idx + 1 < samples.size()) {
-                    // Linear interpolation
-                    resampled[i] = samples[idx] * (1.0f - frac) + samples[idx + 1] * frac;
-                } else if (idx < samples.size()) {
-                    resampled[i] = samples[idx];
-                }
-            }
-            
-            samples = std::move(resampled);
+        // Resample to the playback rate if needed
+        const int target_rate = output_sample_rate;
+        if (!samples.empty() && wav.sample_rate != target_rate) {
+            std::cout << "[WAV] Resampling from " << wav.sample_rate << "Hz to " << target_rate << "Hz" << std::endl;
+            samples = audio::Resampler::convert(samples, wav.sample_rate, target_rate);
         }
         
         return samples;
@@ -173,16 +167,40 @@ struct Orchestrator::Impl {
     bool initialize() {
         std::cout << "[Orchestrator] Initializing components..." << std::endl;
         
-        // Audio Engine
-        audio = std::make_unique<audio::AudioEngine>();
+        // Audio Engine (wake word + VAD run on the capture thread, not the RT callback)
+        audio::AudioConfig audio_config;
+        audio_config.threaded_capture = true;
+        audio_config.realtime = true;  // Falls back to normal scheduling if not permitted
+        audio_config.capture_channels = capture_channels;
+        audio = std::make_unique<audio::AudioEngine>(audio_config);
+        output_sample_rate = audio_config.output_sample_rate;
         if (!audio->initialize()) {
             std::cerr << "[Orchestrator] AudioEngine init failed" << std::endl;
             return false;
         }
         std::cout << "[Orchestrator] AudioEngine OK" << std::endl;
         
+        // Capture chain (HPF -> AEC3 -> BF -> NS -> AGC): AudioEngine feeds its
+        // own render tap into AEC3, and VAD/STT only ever see the cleaned,
+        // beamformed mono signal
+        audio::PipelineConfig pipeline_config;
+        pipeline_config.gain_control = true;
+        aec = std::make_unique<audio::AudioPipeline>(
+            audio_config.sample_rate, audio_config.capture_channels, pipeline_config);
+        if (aec->isInitialized()) {
+            audio->setEchoCanceller(aec.get());
+            std::cout << "[Orchestrator] AudioPipeline (AEC3) OK" << std::endl;
+        } else {
+            std::cerr << "[Orchestrator] Warning: AEC3 unavailable, capturing without echo cancellation" << std::endl;
+        }
+        
         // VAD
         vad = std::make_unique<audio::VADProcessor>();
+        vad->setPreRoll(400);
+        vad->setEnergyGate(true);  // Skip libfvad through room silence
+        vad->setSpeechEventCallback([this](const audio::SpeechEvent& event) {
+            handleSpeechEvent(event);
+        });
         std::cout << "[Orchestrator] VADProcessor OK" << std::endl;
         
         // STT
@@ -227,26 +245,27 @@ struct Orchestrator::Impl {
             
             if (wakeword->isReady()) {
                 std::cout << "[Orchestrator] WakeWordDetector OK (say 'Hi Gemma')" << std::endl;
+                wakeword->setEnergyGate(true);  // Porcupine only sees frames above the noise floor
                 
                 // Load pre-recorded greeting WAV
-                cached_greeting = loadWavFile(greeting_wav);
-                if (!cached_greeting.empty()) {
-                    std::cout << "[Orchestrator] Loaded greeting WAV (" << cached_greeting.size() << " samples)" << std::endl;
+                cached_greeting = audio::makeClip(loadWavFile(greeting_wav));
+                if (hasAudio(cached_greeting)) {
+                    std::cout << "[Orchestrator] Loaded greeting WAV (" << cached_greeting->size() << " samples)" << std::endl;
                 } else {
                     std::cerr << "[Orchestrator] Warning: Greeting WAV not found: " << greeting_wav << std::endl;
                 }
                 
                 // Load notification sounds (optional)
-                cached_wake_sound = loadWavFile(wake_sound_wav);
-                if (!cached_wake_sound.empty()) {
-                    std::cout << "[Orchestrator] Loaded wake sound (" << cached_wake_sound.size() << " samples)" << std::endl;
+                cached_wake_sound = audio::makeClip(loadWavFile(wake_sound_wav, NOTIFICATION_GAIN));
+                if (hasAudio(cached_wake_sound)) {
+                    std::cout << "[Orchestrator] Loaded wake sound (" << cached_wake_sound->size() << " samples)" << std::endl;
                 } else {
                     std::cerr << "[Orchestrator] Warning: Wake sound not found or invalid: " << wake_sound_wav << std::endl;
                 }
                 
-                cached_sleep_sound = loadWavFile(sleep_sound_wav);
-                if (!cached_sleep_sound.empty()) {
-                    std::cout << "[Orchestrator] Loaded sleep sound (" << cached_sleep_sound.size() << " samples)" << std::endl;
+                cached_sleep_sound = audio::makeClip(loadWavFile(sleep_sound_wav, NOTIFICATION_GAIN));
+                if (hasAudio(cached_sleep_sound)) {
+                    std::cout << "[Orchestrator] Loaded sleep sound (" << cached_sleep_sound->size() << " samples)" << std::endl;
                 } else {
                     std::cerr << "[Orchestrator] Warning: Sleep sound not found or invalid: " << sleep_sound_wav << std::endl;
                 }
@@ -279,25 +298,32 @@ struct Orchestrator::Impl {
         std::cout << "[Orchestrator] Running... (say something)" << std::endl;
 #endif
         
-        // Setup audio callback
-        audio->setInputCallback([this](const float* samples, size_t count) {
-            handleAudioInput(samples, count);
-        });
-        
-        // Setup TTS audio callback (output stream runs at 24kHz)
+        // Setup TTS audio callback (converted to the output stream rate)
         tts_streamer->setAudioCallback([this](const std::vector<float>& samples, int sr) {
-            if (!interrupted) {
+            if (interrupted) return;
+            if (sr != output_sample_rate) {
+                // Each chunk is a whole sentence, so convert it standalone
+                audio->queuePlayback(audio::makeClip(
+                    audio::Resampler::convert(samples, sr, output_sample_rate)));
+            } else {
                 audio->queuePlayback(samples.data(), samples.size());
             }
+            notifyEvent();
         });
         
         audio->start();
+        seedEchoDelay();
+        
+        // Setup audio callback (after calibration, so the chirp never reaches VAD)
+        audio->setInputCallback([this](const float* samples, size_t count) {
+            handleAudioInput(samples, count);
+        });
         
         while (running) {
             switch (state.load()) {
                 case OrchestratorState::SLEEPING:
-                    // Wake word is processed in handleAudioInput
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    // Wake word is processed in handleAudioInput, which changes state
+                    waitForEvent(std::chrono::seconds(1));
                     break;
                     
                 case OrchestratorState::IDLE:
@@ -317,8 +343,8 @@ struct Orchestrator::Impl {
                                 awaiting_command = false;
                                 
                                 // Play sleep notification sound (if available)
-                                if (!cached_sleep_sound.empty()) {
-                                    audio->queuePlayback(cached_sleep_sound.data(), cached_sleep_sound.size());
+                                if (hasAudio(cached_sleep_sound)) {
+                                    audio->queuePlayback(cached_sleep_sound);
                                 }
                                 
                                 setState(OrchestratorState::SLEEPING);
@@ -329,7 +355,9 @@ struct Orchestrator::Impl {
                         }
                     }
 #endif
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    // Wake on speech; otherwise re-check the command timeout periodically
+                    waitForEvent(awaiting_command ? std::chrono::milliseconds(250)
+                                                  : std::chrono::seconds(1));
                     break;
                     
                 case OrchestratorState::LISTENING:
@@ -337,8 +365,9 @@ struct Orchestrator::Impl {
                     if (hasSpeechReady()) {
                         awaiting_command = false;  // Got command
                         setState(OrchestratorState::PROCESSING);
+                    } else {
+                        waitForEvent(std::chrono::seconds(1));
                     }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
                     break;
                     
                 case OrchestratorState::PROCESSING:
@@ -355,7 +384,10 @@ struct Orchestrator::Impl {
                         auto speaking_elapsed = std::chrono::steady_clock::now() - speaking_start_time;
                         bool min_time_passed = speaking_elapsed > std::chrono::milliseconds(500);
                         
-                        if (min_time_passed && !tts_streamer->isSpeaking() && !audio->isPlaying()) {
+                        // Wakes as soon as the output path reports the queue drained
+                        bool drained = audio->waitForPlaybackDrained(std::chrono::milliseconds(50));
+                        
+                        if (min_time_passed && drained && !tts_streamer->isSpeaking()) {
 #ifdef RTV_HAS_PORCUPINE
                             if (wakeword && wakeword->isReady()) {
                                 // After any response (greeting or normal), go to IDLE and start timeout
@@ -369,9 +401,14 @@ struct Orchestrator::Impl {
 #else
                             setState(OrchestratorState::IDLE);
 #endif
+                        } else if (drained) {
+                            // Nothing queued right now; wait for TTS audio or the minimum time
+                            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::milliseconds(500) - speaking_elapsed);
+                            waitForEvent(min_time_passed ? std::chrono::milliseconds(50)
+                                                         : std::max(remaining, std::chrono::milliseconds(1)));
                         }
                     }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
                     break;
                     
                 case OrchestratorState::ERROR:
@@ -398,6 +435,75 @@ struct Orchestrator::Impl {
         }
         
         audio->stop();
+        logPipelineStats();
+        logEndpointerStats();
+        logGateStats();
+    }
+    
+    void logPipelineStats() {
+        if (!aec || !aec->isInitialized()) return;
+        
+        audio::PipelineStats stats = aec->getStats();
+        std::cout << "[Orchestrator] Capture chain: " << stats.frames << " frames, "
+                  << stats.load() * 100.0 << "% of real time" << std::endl;
+        for (size_t i = 0; i < audio::kPipelineStages; ++i) {
+            const audio::StageStats& stage = stats.stages[i];
+            if (!stage.enabled && stage.frames == 0) continue;
+            std::cout << "[Orchestrator]   " << audio::stageName(static_cast<audio::PipelineStage>(i))
+                      << ": " << stage.mean_us() << " us/frame (max " << stage.max_ns / 1000 << " us)" << std::endl;
+        }
+        if (stats.worker_thread) {
+            std::cout << "[Orchestrator]   worker: " << stats.frames_late << " frames late, "
+                      << stats.frames_dropped << " dropped" << std::endl;
+        }
+    }
+    
+    void logEndpointerStats() {
+        audio::EndpointerStats stats = vad->endpointer().stats();
+        if (stats.turns == 0) return;
+        std::cout << "[Orchestrator] Endpointer: " << stats.turns << " turns, delay mean "
+                  << stats.mean_delay_ms << "ms (" << stats.min_delay_ms << "-" << stats.max_delay_ms
+                  << "ms), pauses " << stats.pause_mean_ms << " +/- " << stats.pause_stddev_ms
+                  << "ms" << std::endl;
+    }
+    
+    // Share of frames the energy gate kept away from each detector
+    void logGateStats() {
+        auto log = [](const char* name, const audio::EnergyGateStats& stats) {
+            if (stats.frames == 0) return;
+            std::cout << "[Orchestrator] Energy gate (" << name << "): skipped "
+                      << stats.skippedFraction() * 100.0 << "% of " << stats.frames
+                      << " frames, noise floor " << stats.noise_floor_dbfs << " dBFS" << std::endl;
+        };
+        log("VAD", vad->gateStats());
+#ifdef RTV_HAS_PORCUPINE
+        if (wakeword) log("wake word", wakeword->gateStats());
+#endif
+    }
+    
+    /**
+     * Give AEC3 the speaker-to-mic delay up front so it does not have to
+     * search for it after every TTS start. Measured with a chirp the first
+     * time a device pair is seen; delete aec_delay_file to measure again.
+     */
+    void seedEchoDelay() {
+        if (!aec || !aec->isInitialized() || !audio->isRunning()) return;
+        
+        std::string key = audio::DelayCalibrator::deviceKey(*audio);
+        audio::DelayCalibration calibration;
+        if (audio::DelayCalibrator::load(aec_delay_file, key, calibration)) {
+            aec->setDelayHint(calibration.delay_ms);
+            std::cout << "[Orchestrator] AEC delay " << calibration.delay_ms
+                      << "ms (stored for " << key << ")" << std::endl;
+            return;
+        }
+        
+        audio::DelayCalibrator calibrator;
+        if (calibrator.calibrate(*audio, *aec, calibration) && calibration.measured) {
+            audio::DelayCalibrator::save(aec_delay_file, key, calibration);
+            std::cout << "[Orchestrator] AEC delay calibrated: " << calibration.delay_ms
+                      << "ms (saved to " << aec_delay_file << ")" << std::endl;
+        }
     }
     
     void handleAudioInput(const float* samples, size_t count) {
@@ -414,20 +520,19 @@ struct Orchestrator::Impl {
                     audio_buffer.clear();
                 }
                 speech_active = false;
-                silence_frames = 0;
                 
                 setState(OrchestratorState::SPEAKING);
                 speaking_start_time = std::chrono::steady_clock::now();
                 
                 // Play wake notification sound first (if available)
-                if (!cached_wake_sound.empty()) {
-                    audio->queuePlayback(cached_wake_sound.data(), cached_wake_sound.size());
+                if (hasAudio(cached_wake_sound)) {
+                    audio->queuePlayback(cached_wake_sound);
                 }
                 
                 // Then play pre-recorded greeting (instant!)
-                if (!cached_greeting.empty()) {
-                    audio->queuePlayback(cached_greeting.data(), cached_greeting.size());
-                    std::cout << "[Orchestrator] Queued " << cached_greeting.size() << " greeting samples" << std::endl;
+                if (hasAudio(cached_greeting)) {
+                    audio->queuePlayback(cached_greeting);
+                    std::cout << "[Orchestrator] Queued " << cached_greeting->size() << " greeting samples" << std::endl;
                 } else {
                     std::cerr << "[Orchestrator] Warning: No greeting audio cached!" << std::endl;
                 }
@@ -439,39 +544,52 @@ struct Orchestrator::Impl {
         }
 #endif
         
+        // History from before a response (or the wake word, which sits in
+        // the pre-roll) must not leak into the next command
+        if (vad_reset_pending.exchange(false)) {
+            vad->reset();
+        }
+        
         // Ignore audio input while speaking (prevents feedback)
         if (state == OrchestratorState::SPEAKING) {
             return;
         }
         
-        // Process through VAD
+        // Segments arrive through handleSpeechEvent
         vad->process(samples, count);
-        bool is_speech = vad->isSpeaking();
+    }
+    
+    // Capture thread: VAD segment events, pre-roll included. The endpointer
+    // inside the VAD decides when trailing silence ends the turn.
+    void handleSpeechEvent(const audio::SpeechEvent& event) {
+        if (event.type == audio::SpeechEventType::Start &&
+            state == OrchestratorState::IDLE) {
+            setState(OrchestratorState::LISTENING);
+        }
         
-        if (is_speech) {
-            if (state == OrchestratorState::IDLE) {
-                setState(OrchestratorState::LISTENING);
-            }
-            speech_active = true;
-            silence_frames = 0;
-            
-            // Buffer the audio
-            std::lock_guard<std::mutex> lock(buffer_mutex);
-            audio_buffer.insert(audio_buffer.end(), samples, samples + count);
-        } else {
-            // Silence
-            if (speech_active) {
-                // Still buffer a bit of silence for natural ending
-                std::lock_guard<std::mutex> lock(buffer_mutex);
-                audio_buffer.insert(audio_buffer.end(), samples, samples + count);
-                silence_frames++;
-                
-                // End speech after ~500ms of silence (16000 Hz * 0.5s / 512 frames = ~15 frames)
-                if (silence_frames > 15) {
-                    speech_active = false;
-                }
-            }
+        std::lock_guard<std::mutex> lock(buffer_mutex);
+        switch (event.type) {
+            case audio::SpeechEventType::Start:
+                speech_active = true;
+                segment_start = audio_buffer.size();
+                break;
+            case audio::SpeechEventType::Chunk:
+            case audio::SpeechEventType::End:
+                audio_buffer.insert(audio_buffer.end(), event.audio.first.begin(), event.audio.first.end());
+                audio_buffer.insert(audio_buffer.end(), event.audio.second.begin(), event.audio.second.end());
+                break;
+        }
+        if (event.type != audio::SpeechEventType::End) return;
+        
+        speech_active = false;
+        if (!event.accepted) {
+            // Too short to be a command (a cough, a click): drop it
+            audio_buffer.resize(std::min(segment_start, audio_buffer.size()));
+            return;
         }
+        std::cout << "[Orchestrator] End of turn after " << event.endpoint_delay_ms
+                  << "ms silence" << std::endl;
+        notifyEvent();
     }
     
     bool hasSpeechReady() {
@@ -481,8 +599,6 @@ struct Orchestrator::Impl {
         return ready;
     }
     
-    int silence_frames = 0;
-    
     void processSTT() {
         std::vector<float> audio_copy;
         {
@@ -543,16 +659,14 @@ struct Orchestrator::Impl {
         
         tts_streamer->flush();
         
-        // Wait for audio to actually finish playing (with debouncing to avoid race between chunks)
-        // TTSStreamer::flush() returns after synthesis but audio may still be playing
-        int silence_count = 0;
-        while (!interrupted && silence_count < 5) {  // Require 5 consecutive "not playing" checks
-            if (!audio->isPlaying() && !tts_streamer->isSpeaking()) {
-                silence_count++;
-            } else {
-                silence_count = 0;  // Reset if still active
+        // TTSStreamer::flush() returns once every chunk is queued, so the next
+        // drain event from the output path is the real end of the response.
+        // Waits in 100ms slices so a barge-in (interrupted) is seen promptly
+        // instead of after the whole response has played out.
+        while (!interrupted) {
+            if (audio->waitForPlaybackDrained(std::chrono::milliseconds(100))) {
+                break;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         
         std::cout << "[Orchestrator] Rosey: " << full_response << std::endl;
@@ -589,12 +703,16 @@ void Orchestrator::start() {
 
 void Orchestrator::stop() {
     impl_->running = false;
+    impl_->notifyEvent();
     if (impl_->worker_thread.joinable()) {
         impl_->worker_thread.join();
     }
 }
 
-void Orchestrator::interrupt() { impl_->interrupted = true; }
+void Orchestrator::interrupt() {
+    impl_->interrupted = true;
+    impl_->notifyEvent();
+}
 
 bool Orchestrator::isRunning() const { return impl_->running; }
 
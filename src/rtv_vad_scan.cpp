@@ -0,0 +1,348 @@
+/**
+ * rtv_vad_scan.cpp - Offline VAD segmentation over recorded sessions
+ *
+ * Runs VADProcessor over a directory of WAV files (or a list of files) on
+ * a pool of worker threads, one VADProcessor (and so one fvad instance)
+ * per worker, to tune VADMode, silence timeout and minimum speech length
+ * without replaying sessions through a microphone.
+ *
+ * Prints one line per file (segments, speech ratio, throughput as a
+ * multiple of real time) and a total; --segments writes every accepted
+ * segment's boundaries to a CSV file.
+ *
+ * Usage: rtv_vad_scan [options] <dir|file.wav>...
+ */
+
+#include "rtv/audio/EnergyGate.hpp"
+#include "rtv/audio/Resampler.hpp"
+#include "rtv/audio/SegmentTracker.hpp"
+#include "rtv/audio/VADProcessor.hpp"
+#include "rtv/audio/WavFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtv::audio;
+using Clock = std::chrono::steady_clock;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int SCAN_RATE = 16000;  // Files are resampled to the capture rate
+
+struct ScanOptions {
+    int mode = 2;              // VADMode (0-3)
+    int frame_ms = 20;
+    int silence_ms = 500;      // Endpointer upper bound
+    int min_speech_ms = 200;
+    int pre_roll_ms = 300;
+    bool energy_gate = false;
+    unsigned threads = 0;      // 0 = hardware concurrency
+    std::string segments_csv;
+};
+
+struct Segment {
+    double start_s;         // Pre-roll included, as the STT would receive it
+    double speech_start_s;  // First speech frame
+    double speech_end_s;    // Last speech frame
+    double end_s;           // Endpoint (speech end + trailing silence)
+};
+
+struct FileResult {
+    std::string path;
+    std::string error;
+    double duration_s = 0.0;
+    double vad_s = 0.0;         // Time spent in VADProcessor
+    double speech_s = 0.0;      // Accepted segments, pre-roll and trailing silence excluded
+    int rejected = 0;           // Segments below the minimum speech duration
+    double gate_skipped = 0.0;  // Fraction of frames the energy gate skipped
+    std::vector<Segment> segments;
+
+    double speechRatio() const { return duration_s > 0.0 ? speech_s / duration_s : 0.0; }
+    double realtimeFactor() const { return vad_s > 0.0 ? duration_s / vad_s : 0.0; }
+};
+
+void printUsage() {
+    std::cout << "Usage: rtv_vad_scan [options] <dir|file.wav>...\n"
+              << "  --mode N           VAD aggressiveness 0-3 (default 2)\n"
+              << "  --frame-ms N       VAD frame: 10, 20 or 30 (default 20)\n"
+              << "  --silence-ms N     Longest trailing silence before a turn ends (default 500)\n"
+              << "  --min-speech-ms N  Shorter segments are rejected (default 200)\n"
+              << "  --pre-roll-ms N    Audio kept before speech onset (default 300)\n"
+              << "  --energy-gate      Skip fvad on frames near the noise floor\n"
+              << "  --threads N        Worker threads (default: all cores)\n"
+              << "  --segments FILE    Write accepted segment boundaries as CSV\n";
+}
+
+bool parseArgs(int argc, char** argv, ScanOptions& options, std::vector<std::string>& inputs) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "[VADScan] Missing value for " << arg << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            return false;
+        } else if (arg == "--energy-gate") {
+            options.energy_gate = true;
+        } else if (arg == "--segments") {
+            const char* v = value();
+            if (!v) return false;
+            options.segments_csv = v;
+        } else if (arg == "--mode" || arg == "--frame-ms" || arg == "--silence-ms" ||
+                   arg == "--min-speech-ms" || arg == "--pre-roll-ms" || arg == "--threads") {
+            const char* v = value();
+            if (!v) return false;
+            int n = std::atoi(v);
+            if (arg == "--mode") options.mode = n;
+            else if (arg == "--frame-ms") options.frame_ms = n;
+            else if (arg == "--silence-ms") options.silence_ms = n;
+            else if (arg == "--min-speech-ms") options.min_speech_ms = n;
+            else if (arg == "--pre-roll-ms") options.pre_roll_ms = n;
+            else options.threads = static_cast<unsigned>(std::max(n, 0));
+        } else if (arg.starts_with("--")) {
+            std::cerr << "[VADScan] Unknown option: " << arg << std::endl;
+            return false;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (options.mode < 0 || options.mode > 3) {
+        std::cerr << "[VADScan] --mode must be 0-3" << std::endl;
+        return false;
+    }
+    if (options.frame_ms != 10 && options.frame_ms != 20 && options.frame_ms != 30) {
+        std::cerr << "[VADScan] --frame-ms must be 10, 20 or 30" << std::endl;
+        return false;
+    }
+    return !inputs.empty();
+}
+
+// WAV files under each input, sorted so the report order is stable
+std::vector<std::string> collectFiles(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        std::error_code ec;
+        if (fs::is_directory(input, ec)) {
+            for (const auto& entry : fs::recursive_directory_iterator(input, ec)) {
+                std::string ext = entry.path().extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                if (entry.is_regular_file() && ext == ".wav") {
+                    files.push_back(entry.path().string());
+                }
+            }
+        } else if (fs::is_regular_file(input, ec)) {
+            files.push_back(input);
+        } else {
+            std::cerr << "[VADScan] Not found: " << input << std::endl;
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+
+/**
+ * One worker's detector, reused across files
+ */
+class Scanner {
+public:
+    explicit Scanner(const ScanOptions& options)
+        : options_(options)
+        , vad_(SCAN_RATE, static_cast<VADMode>(options.mode), options.frame_ms)
+        , frame_samples_(static_cast<size_t>(SCAN_RATE) * options.frame_ms / 1000)
+        , tracker_(frame_samples_, SCAN_RATE)
+    {
+        vad_.setSilenceTimeout(options.silence_ms);
+        vad_.setMinSpeechDuration(options.min_speech_ms);
+        vad_.setPreRoll(options.pre_roll_ms);
+        vad_.setSpeechEventCallback([this](const SpeechEvent& event) { onEvent(event); });
+    }
+
+    FileResult scan(const std::string& path) {
+        FileResult result;
+        result.path = path;
+
+        WavData wav;
+        if (!readWav(path, wav, &result.error)) {
+            if (result.error.empty()) result.error = "unreadable WAV";
+            return result;
+        }
+
+        std::vector<float> mono = downmixToMono(wav);
+        if (wav.sample_rate != SCAN_RATE) {
+            mono = Resampler::convert(mono, wav.sample_rate, SCAN_RATE);
+        }
+        result.duration_s = static_cast<double>(mono.size()) / SCAN_RATE;
+
+        // Fresh detector state, so results do not depend on which worker
+        // scanned which file before
+        vad_.reset();
+        vad_.endpointer() = Endpointer(vad_.endpointer().config());
+        if (options_.energy_gate) vad_.setEnergyGate(true);
+
+        current_ = &result;
+        fed_ = 0;
+
+        // Whole frames, so the stream position is exact in the callback
+        auto start = Clock::now();
+        for (; fed_ + frame_samples_ <= mono.size(); ) {
+            const float* frame = mono.data() + fed_;
+            fed_ += frame_samples_;
+            vad_.process(frame, frame_samples_);
+        }
+        result.vad_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // A segment still open when the file ends never reached its
+        // endpoint; it is dropped rather than counted as rejected
+        current_ = nullptr;
+        vad_.reset();
+
+        if (options_.energy_gate) result.gate_skipped = vad_.gateStats().skippedFraction();
+        return result;
+    }
+
+private:
+    void onEvent(const SpeechEvent& event) {
+        if (!current_) return;
+        if (event.type == SpeechEventType::End && !event.accepted) {
+            current_->rejected++;
+            return;
+        }
+        if (!tracker_.onEvent(event, fed_)) return;
+
+        const SegmentBounds& bounds = tracker_.last();
+        auto seconds = [](size_t samples) { return static_cast<double>(samples) / SCAN_RATE; };
+        Segment segment;
+        segment.start_s = seconds(bounds.start);
+        segment.speech_start_s = seconds(bounds.speech_start);
+        segment.speech_end_s = seconds(bounds.speech_end);
+        segment.end_s = seconds(bounds.end);
+        current_->speech_s += segment.speech_end_s - segment.speech_start_s;
+        current_->segments.push_back(segment);
+    }
+
+    const ScanOptions& options_;
+    VADProcessor vad_;
+    size_t frame_samples_;
+    SegmentTracker tracker_;
+
+    FileResult* current_ = nullptr;
+    size_t fed_ = 0;  // Samples fed for the current file
+};
+
+void writeSegments(const std::string& path, const std::vector<FileResult>& results) {
+    std::ofstream csv(path);
+    if (!csv) {
+        std::cerr << "[VADScan] Cannot write " << path << std::endl;
+        return;
+    }
+    csv << "file,segment,start_s,speech_start_s,speech_end_s,end_s\n" << std::fixed << std::setprecision(3);
+    for (const auto& r : results) {
+        for (size_t i = 0; i < r.segments.size(); ++i) {
+            const Segment& s = r.segments[i];
+            csv << r.path << ',' << i << ',' << s.start_s << ',' << s.speech_start_s << ',' << s.speech_end_s << ',' << s.end_s << '\n';
+        }
+    }
+    std::cout << "[VADScan] Segments written to " << path << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ScanOptions options;
+    std::vector<std::string> inputs;
+    if (!parseArgs(argc, argv, options, inputs)) {
+        printUsage();
+        return 1;
+    }
+
+    const std::vector<std::string> files = collectFiles(inputs);
+    if (files.empty()) {
+        std::cerr << "[VADScan] No WAV files found" << std::endl;
+        return 1;
+    }
+
+    unsigned threads = options.threads > 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp<unsigned>(threads, 1, static_cast<unsigned>(files.size()));
+
+    std::cout << "[VADScan] " << files.size() << " files, " << threads << " threads (mode="
+              << options.mode << ", frame=" << options.frame_ms << "ms, silence<="
+              << options.silence_ms << "ms, min speech=" << options.min_speech_ms << "ms"
+              << (options.energy_gate ? ", energy gate" : "") << ")" << std::endl;
+
+    // Workers pull the next file index; each result has its own slot
+    std::vector<FileResult> results(files.size());
+    std::atomic<size_t> next{0};
+    auto start = Clock::now();
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            Scanner scanner(options);
+            for (size_t i = next++; i < files.size(); i = next++) {
+                results[i] = scanner.scan(files[i]);
+            }
+        });
+    }
+    for (auto& worker : pool) worker.join();
+
+    const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Per-file report, in path order
+    double total_audio_s = 0.0;
+    double total_speech_s = 0.0;
+    size_t total_segments = 0;
+    size_t failed = 0;
+
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        if (!r.error.empty()) {
+            std::cerr << "[VADScan] " << r.path << ": " << r.error << std::endl;
+            failed++;
+            continue;
+        }
+        total_audio_s += r.duration_s;
+        total_speech_s += r.speech_s;
+        total_segments += r.segments.size();
+
+        std::cout << r.path << "  " << std::setprecision(1) << r.duration_s << "s  "
+                  << r.segments.size() << " segments (" << r.rejected << " rejected)  speech "
+                  << r.speechRatio() * 100.0 << "%  " << std::setprecision(0)
+                  << r.realtimeFactor() << "x real time";
+        if (options.energy_gate) {
+            std::cout << "  gate skipped " << std::setprecision(1) << r.gate_skipped * 100.0 << "%";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "[VADScan] " << results.size() - failed << " files, " << std::setprecision(2)
+              << total_audio_s / 3600.0 << " h audio, " << total_segments << " segments, speech "
+              << std::setprecision(1) << (total_audio_s > 0.0 ? total_speech_s / total_audio_s * 100.0 : 0.0)
+              << "%, " << wall_s << " s wall (" << std::setprecision(0)
+              << (wall_s > 0.0 ? total_audio_s / wall_s : 0.0) << "x real time)" << std::endl;
+    if (failed > 0) {
+        std::cerr << "[VADScan] " << failed << " files could not be read" << std::endl;
+    }
+
+    if (!options.segments_csv.empty()) {
+        writeSegments(options.segments_csv, results);
+    }
+    return failed == results.size() ? 1 : 0;
+}
@@ -35,7 +35,6 @@ struct TTSStreamer::Impl {
     std::thread synth_thread;
     std::atomic<bool> synth_running{false};
     std::atomic<bool> synth_in_progress{false};  // True while synthesizing a sentence
-    int current_sample_rate = 24000;
     
     explicit Impl(TTSEngine& eng) : engine(eng) {}
     
@@ -82,16 +81,16 @@ struct TTSStreamer::Impl {
             // Synthesize (this is the slow part)
             auto audio = engine.synthesize(sentence);
             
-            synth_in_progress = false;  // Done synthesizing this sentence
-            
-            if (!audio.empty() && !should_stop) {
-                // Enqueue audio for playback
-                {
-                    std::lock_guard<std::mutex> lock(queue_mutex);
+            // Publish the audio and the end of synthesis together, so flush()
+            // never sees "nothing in progress" before the audio is queued
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (!audio.empty() && !should_stop) {
                     audio_queue.push(std::move(audio));
                 }
-                audio_cv.notify_one();
+                synth_in_progress = false;  // Done synthesizing this sentence
             }
+            audio_cv.notify_all();
         }
     }
     
@@ -142,8 +141,8 @@ struct TTSStreamer::Impl {
             {
                 std::unique_lock<std::mutex> lock(queue_mutex);
                 
-                // Wait for audio or check if done
-                audio_cv.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+                // Woken by the synth worker when audio is queued or synthesis ends
+                audio_cv.wait(lock, [this]() {
                     return !audio_queue.empty() || should_stop || 
                            (sentence_queue.empty() && audio_queue.empty() && !synth_in_progress);
                 });
@@ -166,7 +165,7 @@ struct TTSStreamer::Impl {
             // Play audio (blocking until queued)
             if (!audio.empty() && callback) {
                 std::cout << "[TTSStreamer] flush() - playing " << audio.size() << " samples" << std::endl;
-                callback(audio, current_sample_rate);
+                callback(audio, engine.getSampleRate());
             }
         }
         
@@ -3,7 +3,10 @@
  */
 
 #include "rtv/wakeword/WakeWordDetector.hpp"
+#include "rtv/audio/EnergyGate.hpp"
+#include "rtv/audio/SampleConvert.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <vector>
@@ -20,7 +23,11 @@ struct WakeWordDetector::Impl {
     WakeWordCallback callback;
     int frame_length = 512;
     bool ready = false;
-    std::vector<int16_t> int16_buffer;
+    std::vector<int16_t> int16_buffer;  // One frame, filled by processFloat
+    size_t frame_fill = 0;
+    
+    // Optional level pre-gate: skips Porcupine on frames far below speech level
+    std::unique_ptr<audio::EnergyGate> gate;
     
     Impl(const std::string& access_key,
          const std::string& model_path,
@@ -94,29 +101,40 @@ struct WakeWordDetector::Impl {
         return keyword_index;
     }
     
+    // One frame through the gate (when enabled); lookback frames held back
+    // while it was closed are run first so the keyword onset is not lost
+    int processGated(const int16_t* samples) {
+        if (!gate) return process(samples);
+        
+        int result = -1;
+        gate->process(samples, [&](const int16_t* frame) {
+            int idx = process(frame);
+            if (idx >= 0) result = idx;
+        });
+        return result;
+    }
+    
     int processFloat(const float* samples, size_t count) {
         if (!ready || !porcupine) return -1;
         
-        // Accumulate samples until we have a full frame
-        static std::vector<int16_t> accumulator;
-        
-        // Convert float to int16
-        for (size_t i = 0; i < count; i++) {
-            float sample = samples[i];
-            if (sample > 1.0f) sample = 1.0f;
-            if (sample < -1.0f) sample = -1.0f;
-            accumulator.push_back(static_cast<int16_t>(sample * 32767.0f));
-        }
-        
+        const size_t frame = int16_buffer.size();
         int result = -1;
         
-        // Process full frames
-        while (accumulator.size() >= static_cast<size_t>(frame_length)) {
-            int idx = process(accumulator.data());
+        // Convert straight into this detector's frame; Porcupine runs each
+        // time it fills, and a partial frame waits for the next block
+        while (count > 0) {
+            size_t n = std::min(count, frame - frame_fill);
+            audio::floatToInt16(samples, int16_buffer.data() + frame_fill, n);
+            frame_fill += n;
+            samples += n;
+            count -= n;
+            if (frame_fill < frame) break;
+            
+            int idx = processGated(int16_buffer.data());
             if (idx >= 0) {
                 result = idx;  // Return last detection
             }
-            accumulator.erase(accumulator.begin(), accumulator.begin() + frame_length);
+            frame_fill = 0;
         }
         
         return result;
@@ -146,13 +164,25 @@ int WakeWordDetector::getSampleRate() const {
 }
 
 int WakeWordDetector::process(const int16_t* samples) {
-    return impl_->process(samples);
+    return impl_->processGated(samples);
 }
 
 int WakeWordDetector::processFloat(const float* samples, size_t count) {
     return impl_->processFloat(samples, count);
 }
 
+void WakeWordDetector::setEnergyGate(bool enabled, const audio::EnergyGateConfig& config) {
+    if (enabled && impl_->ready) {
+        impl_->gate = std::make_unique<audio::EnergyGate>(impl_->frame_length, getSampleRate(), config);
+    } else {
+        impl_->gate.reset();
+    }
+}
+
+audio::EnergyGateStats WakeWordDetector::gateStats() const {
+    return impl_->gate ? impl_->gate->stats() : audio::EnergyGateStats();
+}
+
 void WakeWordDetector::setCallback(WakeWordCallback callback) {
     impl_->callback = std::move(callback);
 }
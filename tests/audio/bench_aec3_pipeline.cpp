@@ -0,0 +1,157 @@
+/**
+ * bench_aec3_pipeline.cpp - AEC3 capture path cost per block
+ *
+ * Compares the previous accumulate/erase framing (one push_back per sample,
+ * front erase per frame, fresh output vector per call) against
+ * FrameAssembler with a caller-owned output buffer, first in isolation and
+ * then through AudioPipeline with AEC3 running. Reports time and heap
+ * allocations per capture block.
+ *
+ * Usage: rtv_aec3_pipeline_bench [block_size]
+ */
+
+#include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/FrameAssembler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace rtv::audio;
+using Clock = std::chrono::steady_clock;
+
+// ---- Allocation counting ----
+
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ---- Previous framing, reproduced for comparison ----
+
+struct LegacyFraming {
+    size_t frame;
+    std::vector<float> accumulator;
+    std::vector<float> scratch;  // Stands in for the AEC3 AudioBuffer
+
+    explicit LegacyFraming(size_t frame_size) : frame(frame_size), scratch(frame_size) {}
+
+    std::vector<float> process(const float* samples, size_t count) {
+        std::vector<float> output;
+        output.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            accumulator.push_back(samples[i]);
+        }
+        while (accumulator.size() >= frame) {
+            for (size_t i = 0; i < frame; ++i) scratch[i] = accumulator[i];
+            for (size_t i = 0; i < frame; ++i) output.push_back(scratch[i]);
+            accumulator.erase(accumulator.begin(), accumulator.begin() + frame);
+        }
+        return output;
+    }
+};
+
+struct Result {
+    double us_per_block;
+    double allocs_per_block;
+};
+
+template <typename Fn>
+Result measure(size_t blocks, Fn&& fn) {
+    uint64_t allocs = g_allocations.load();
+    auto start = Clock::now();
+    for (size_t i = 0; i < blocks; ++i) fn(i);
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return {us / blocks, static_cast<double>(g_allocations.load() - allocs) / blocks};
+}
+
+static void print(const char* name, const Result& r) {
+    std::cout << "  " << std::left << std::setw(26) << name
+              << std::right << std::setw(9) << r.us_per_block << " us/block  "
+              << std::setw(6) << r.allocs_per_block << " allocs/block" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const int sample_rate = 16000;
+    const size_t block = (argc >= 2) ? static_cast<size_t>(std::atoi(argv[1])) : 512;
+    const size_t frame = sample_rate / 100;
+    const double seconds = 20.0;
+    const size_t blocks = static_cast<size_t>(seconds * sample_rate / block);
+
+    std::cout << "=== AEC3 Pipeline Benchmark ===" << std::endl;
+    std::cout << "Block " << block << " samples, " << seconds << "s of audio ("
+              << blocks << " blocks)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Render is noise; capture is a delayed, attenuated echo of it plus near-end noise
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    std::vector<float> render(blocks * block);
+    std::vector<float> capture(blocks * block);
+    for (size_t i = 0; i < render.size(); ++i) {
+        render[i] = noise(rng);
+        capture[i] = (i >= 800 ? 0.5f * render[i - 800] : 0.0f) + 0.1f * noise(rng);
+    }
+
+    // Framing alone
+    std::cout << "\n--- Framing only ---" << std::endl;
+    {
+        LegacyFraming legacy(frame);
+        float sink = 0.0f;
+        print("legacy accumulate/erase", measure(blocks, [&](size_t i) {
+            auto out = legacy.process(capture.data() + i * block, block);
+            if (!out.empty()) sink += out[0];
+        }));
+
+        FrameAssembler assembler(frame);
+        std::vector<float> scratch(frame);
+        std::vector<float> out(block + frame);
+        print("FrameAssembler", measure(blocks, [&](size_t i) {
+            size_t written = 0;
+            assembler.push(capture.data() + i * block, block, [&](const float* f) {
+                std::copy_n(f, frame, scratch.data());
+                std::copy_n(scratch.data(), frame, out.data() + written);
+                written += frame;
+            });
+            if (written) sink += out[0];
+        }));
+        if (sink == 12345.0f) std::cout << "";
+    }
+
+    // Full AEC3 path
+    std::cout << "\n--- AudioPipeline (AEC3) ---" << std::endl;
+    {
+        AudioPipeline pipeline(sample_rate, 1);
+        if (!pipeline.isInitialized()) {
+            std::cout << "  AEC3 unavailable, skipping" << std::endl;
+            return 0;
+        }
+        print("processCapture -> vector", measure(blocks, [&](size_t i) {
+            pipeline.feedRenderAudio(render.data() + i * block, block);
+            auto out = pipeline.processCapture(capture.data() + i * block, block);
+            (void)out;
+        }));
+    }
+    {
+        AudioPipeline pipeline(sample_rate, 1);
+        std::vector<float> out(block + pipeline.samplesPerFrame());
+        print("processCapture -> buffer", measure(blocks, [&](size_t i) {
+            pipeline.feedRenderAudio(render.data() + i * block, block);
+            pipeline.processCapture(capture.data() + i * block, block, out.data());
+        }));
+    }
+
+    std::cout << "\nAllocations left in the buffer path come from AEC3 itself." << std::endl;
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * bench_ring_buffer.cpp - RingBuffer throughput and cross-core latency
+ *
+ * Compares the current RingBuffer (cache-line-isolated indices, span API)
+ * against the previous layout (shared index line, no cached indices).
+ *
+ * Usage: rtv_ring_buffer_bench [producer_core consumer_core]
+ */
+
+#include "rtv/audio/RingBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace rtv::audio;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The previous RingBuffer: both indices on one cache line and every call
+ * loads the other side's index.
+ */
+template <typename T>
+class LegacyRingBuffer {
+public:
+    explicit LegacyRingBuffer(size_t capacity) : buffer_(capacity + 1), capacity_(capacity + 1) {}
+
+    size_t push(const T* data, size_t count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t free = (tail + capacity_ - head - 1) % capacity_;
+        count = std::min(count, free);
+        for (size_t i = 0; i < count; ++i) {
+            buffer_[(head + i) % capacity_] = data[i];
+        }
+        head_.store((head + count) % capacity_, std::memory_order_release);
+        return count;
+    }
+
+    size_t pop(T* data, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t ready = (head + capacity_ - tail) % capacity_;
+        count = std::min(count, ready);
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = buffer_[(tail + i) % capacity_];
+        }
+        tail_.store((tail + count) % capacity_, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::vector<T> buffer_;
+    size_t capacity_;
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+};
+
+static int g_producerCore = 0;
+static int g_consumerCore = 1;
+static bool g_sharedCore = false;  // Spinning threads must yield to each other
+
+/**
+ * Busy-wait step; yields only when both threads share one CPU
+ */
+static inline void relax() {
+    if (g_sharedCore) std::this_thread::yield();
+}
+
+static void pinTo(int core) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+constexpr size_t kCapacity = 16000;
+constexpr size_t kBlock = 256;
+constexpr size_t kTotal = size_t(1) << 26;  // Samples per throughput run
+constexpr int kRoundTrips = 200000;
+
+/**
+ * Copying push/pop: one producer and one consumer moving kTotal samples
+ */
+template <typename Ring>
+double throughputCopy() {
+    Ring ring(kCapacity);
+    std::vector<float> in(kBlock, 1.0f);
+
+    auto start = Clock::now();
+    std::thread producer([&]() {
+        pinTo(g_producerCore);
+        for (size_t sent = 0; sent < kTotal;) {
+            size_t n = ring.push(in.data(), std::min(kBlock, kTotal - sent));
+            if (n == 0) relax();
+            sent += n;
+        }
+    });
+
+    pinTo(g_consumerCore);
+    std::vector<float> out(kBlock);
+    float sink = 0.0f;
+    for (size_t received = 0; received < kTotal;) {
+        size_t n = ring.pop(out.data(), kBlock);
+        if (n) sink += out[0]; else relax();
+        received += n;
+    }
+    producer.join();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (sink < 0.0f) std::cout << "";
+    return kTotal / seconds / 1e6;
+}
+
+/**
+ * Span API: producer fills ring storage directly, consumer reads it in place
+ */
+double throughputInPlace() {
+    RingBuffer<float> ring(kCapacity);
+
+    auto start = Clock::now();
+    std::thread producer([&]() {
+        pinTo(g_producerCore);
+        for (size_t sent = 0; sent < kTotal;) {
+            auto w = ring.acquire_write(std::min(kBlock, kTotal - sent));
+            std::fill(w.first.begin(), w.first.end(), 1.0f);
+            std::fill(w.second.begin(), w.second.end(), 1.0f);
+            ring.commit_write(w.size());
+            if (w.empty()) relax();
+            sent += w.size();
+        }
+    });
+
+    pinTo(g_consumerCore);
+    float sink = 0.0f;
+    for (size_t received = 0; received < kTotal;) {
+        auto r = ring.peek_read(kBlock);
+        if (!r.first.empty()) sink += r.first[0]; else relax();
+        ring.consume(r.size());
+        received += r.size();
+    }
+    producer.join();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (sink < 0.0f) std::cout << "";
+    return kTotal / seconds / 1e6;
+}
+
+/**
+ * Ping-pong one sample across two rings; reports one-way latency in ns
+ */
+template <typename Ring>
+void latency(const char* name) {
+    Ring ping(kCapacity);
+    Ring pong(kCapacity);
+
+    std::thread echo([&]() {
+        pinTo(g_consumerCore);
+        float v;
+        for (int i = 0; i < kRoundTrips; ++i) {
+            while (ping.pop(&v, 1) == 0) relax();
+            while (pong.push(&v, 1) == 0) relax();
+        }
+    });
+
+    pinTo(g_producerCore);
+    std::vector<double> samples(kRoundTrips);
+    float v = 1.0f;
+    for (int i = 0; i < kRoundTrips; ++i) {
+        auto t0 = Clock::now();
+        ping.push(&v, 1);
+        while (pong.pop(&v, 1) == 0) relax();
+        samples[i] = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / 2.0;
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    std::cout << "  " << std::left << std::setw(22) << name
+              << " p50=" << std::setw(7) << samples[kRoundTrips / 2]
+              << " p99=" << std::setw(7) << samples[kRoundTrips * 99 / 100]
+              << " ns" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3) {
+        g_producerCore = std::atoi(argv[1]);
+        g_consumerCore = std::atoi(argv[2]);
+    }
+
+    g_sharedCore = std::thread::hardware_concurrency() < 2 || g_producerCore == g_consumerCore;
+
+    std::cout << "=== RingBuffer Benchmark ===" << std::endl;
+    if (g_sharedCore) {
+        std::cout << "Warning: producer and consumer share a CPU; latency reflects scheduling, not cache traffic" << std::endl;
+    }
+    std::cout << "Cores: producer=" << g_producerCore << " consumer=" << g_consumerCore
+              << ", capacity=" << kCapacity << ", block=" << kBlock << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "\n--- Throughput (Msamples/s) ---" << std::endl;
+    std::cout << "  legacy push/pop        " << throughputCopy<LegacyRingBuffer<float>>() << std::endl;
+    std::cout << "  RingBuffer push/pop    " << throughputCopy<RingBuffer<float>>() << std::endl;
+    std::cout << "  RingBuffer in place    " << throughputInPlace() << std::endl;
+
+    std::cout << "\n--- Cross-core latency (one way) ---" << std::endl;
+    latency<LegacyRingBuffer<float>>("legacy");
+    latency<RingBuffer<float>>("RingBuffer");
+
+    return 0;
+}
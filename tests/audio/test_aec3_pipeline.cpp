@@ -7,7 +7,9 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 using namespace rtv::audio;
 
@@ -83,6 +85,288 @@ void test_echo_cancellation() {
     }
 }
 
+void test_caller_buffer_overload() {
+    std::cout << "\n--- Test: Caller Buffer Overload ---" << std::endl;
+    
+    AudioPipeline a(16000, 1);
+    AudioPipeline b(16000, 1);
+    if (!a.isInitialized() || !b.isInitialized()) {
+        std::cout << "[SKIP] AEC3 not initialized" << std::endl;
+        return;
+    }
+    
+    auto render = generateSineWave(16000, 300.0f, 0.5f);
+    auto capture = generateSineWave(16000, 300.0f, 0.5f);
+    
+    // Odd block sizes exercise partial frames on both sides of every block
+    const size_t blocks[] = {37, 512, 160, 333, 1};
+    std::vector<float> viaVector;
+    std::vector<float> viaBuffer;
+    std::vector<float> out(512 + a.samplesPerFrame());
+    
+    size_t pos = 0;
+    for (size_t i = 0; pos < capture.size(); ++i) {
+        size_t n = std::min(blocks[i % 5], capture.size() - pos);
+        a.feedRenderAudio(render.data() + pos, n);
+        b.feedRenderAudio(render.data() + pos, n);
+        
+        auto v = a.processCapture(capture.data() + pos, n);
+        viaVector.insert(viaVector.end(), v.begin(), v.end());
+        
+        size_t produced = b.processCapture(capture.data() + pos, n, out.data());
+        viaBuffer.insert(viaBuffer.end(), out.begin(), out.begin() + produced);
+        pos += n;
+    }
+    
+    size_t expected = capture.size() / a.samplesPerFrame() * a.samplesPerFrame();
+    bool same = viaVector == viaBuffer;
+    std::cout << "  Output samples: " << viaBuffer.size() << " (expected " << expected << ")" << std::endl;
+    
+    if (viaBuffer.size() == expected && same) {
+        std::cout << "[PASS] Caller buffer overload matches vector overload" << std::endl;
+    } else {
+        std::cout << "[FAIL] Caller buffer overload output differs" << std::endl;
+    }
+}
+
+void test_metrics() {
+    std::cout << "\n--- Test: AEC3 Metrics ---" << std::endl;
+    
+    AudioPipeline pipeline(16000, 1);
+    if (!pipeline.isInitialized()) {
+        std::cout << "[SKIP] AEC3 not initialized" << std::endl;
+        return;
+    }
+    pipeline.setMetricsInterval(10);
+    
+    // 2s of render with a delayed, attenuated echo in the capture
+    auto render = generateSineWave(16000, 500.0f, 2.0f);
+    std::vector<float> capture(render.size(), 0.0f);
+    for (size_t i = 800; i < capture.size(); ++i) {
+        capture[i] = 0.5f * render[i - 800];
+    }
+    
+    std::vector<float> out(160 + pipeline.samplesPerFrame());
+    for (size_t pos = 0; pos + 160 <= capture.size(); pos += 160) {
+        pipeline.feedRenderAudio(render.data() + pos, 160);
+        pipeline.processCapture(capture.data() + pos, 160, out.data());
+    }
+    
+    AecMetrics m = pipeline.getMetrics();
+    std::cout << "  Updates:         " << m.updates << " over " << m.frames << " frames" << std::endl;
+    std::cout << "  ERLE:            " << m.erle_db << " dB" << std::endl;
+    std::cout << "  ERL:             " << m.erl_db << " dB" << std::endl;
+    std::cout << "  Delay:           " << m.delay_ms << " ms" << std::endl;
+    std::cout << "  Echo likelihood: " << m.echo_likelihood << std::endl;
+    
+    bool refreshed = m.frames == 200 && m.updates == 20 && m.render_active;
+    bool consistent = pipeline.getERLE() == static_cast<float>(m.erle_db) &&
+                      pipeline.isEchoDetected() == m.echo_detected &&
+                      m.echo_likelihood >= 0.0f && m.echo_likelihood <= 1.0f;
+    
+    pipeline.reset();
+    bool cleared = pipeline.getMetrics().updates == 0 && !pipeline.isEchoDetected();
+    
+    if (refreshed && consistent && cleared) {
+        std::cout << "[PASS] Metrics refresh every interval and reset cleanly" << std::endl;
+    } else {
+        std::cout << "[FAIL] Metrics refreshed=" << refreshed << " consistent=" << consistent
+                  << " cleared=" << cleared << std::endl;
+    }
+}
+
+void test_processing_chain() {
+    std::cout << "\n--- Test: Processing Chain ---" << std::endl;
+    
+    // AGC alone, so its effect is not mixed with the WebRTC stages
+    PipelineConfig config;
+    config.high_pass = false;
+    config.echo_cancellation = false;
+    config.noise_suppression = false;
+    config.gain_control = true;
+    AudioPipeline pipeline(16000, 1, config);
+    if (!pipeline.isInitialized()) {
+        std::cout << "[SKIP] AEC3 not initialized" << std::endl;
+        return;
+    }
+    
+    // Quiet talker: 300Hz at -40 dBFS RMS for 5s
+    auto input = generateSineWave(16000, 300.0f, 5.0f);
+    for (float& s : input) s *= 0.01414f / 0.5f;
+    
+    std::vector<float> output(input.size() + pipeline.samplesPerFrame());
+    size_t produced = 0;
+    for (size_t pos = 0; pos < input.size(); pos += 512) {
+        size_t n = std::min<size_t>(512, input.size() - pos);
+        produced += pipeline.processCapture(input.data() + pos, n, output.data() + produced);
+    }
+    
+    // Last second, once the gain has settled
+    double in_energy = 0.0, out_energy = 0.0;
+    float peak = 0.0f;
+    for (size_t i = produced - 16000; i < produced; ++i) {
+        in_energy += input[i] * input[i];
+        out_energy += output[i] * output[i];
+        peak = std::max(peak, std::abs(output[i]));
+    }
+    double gain_db = 10.0 * std::log10(out_energy / in_energy);
+    
+    PipelineStats stats = pipeline.getStats();
+    const StageStats& agc = stats[PipelineStage::GainControl];
+    std::cout << "  AGC gain:    " << gain_db << " dB (peak " << peak << ")" << std::endl;
+    std::cout << "  AGC time:    " << agc.mean_us() << " us/frame, load " << stats.load() * 100.0 << "%" << std::endl;
+    
+    bool boosted = gain_db > 12.0 && gain_db < 18.5 && peak <= 0.9f + 1e-4f;
+    bool accounted = stats.frames == produced / 160 && agc.frames == stats.frames &&
+                     stats[PipelineStage::EchoCancel].frames == 0 && !stats[PipelineStage::EchoCancel].enabled;
+    
+    // Runtime toggle: AEC3 on, AGC off
+    pipeline.setStageEnabled(PipelineStage::GainControl, false);
+    pipeline.setStageEnabled(PipelineStage::EchoCancel, true);
+    pipeline.resetStats();
+    pipeline.processCapture(input.data(), 1600, output.data());
+    stats = pipeline.getStats();
+    bool toggled = pipeline.isStageEnabled(PipelineStage::EchoCancel) &&
+                   stats[PipelineStage::EchoCancel].frames == 10 &&
+                   stats[PipelineStage::GainControl].frames == 0;
+    
+    if (boosted && accounted && toggled) {
+        std::cout << "[PASS] Chain stages run, toggle and are timed independently" << std::endl;
+    } else {
+        std::cout << "[FAIL] Chain boosted=" << boosted << " accounted=" << accounted
+                  << " toggled=" << toggled << std::endl;
+    }
+}
+
+void test_mic_array() {
+    std::cout << "\n--- Test: Mic Array ---" << std::endl;
+    
+    // Per-mic AEC3 and the beamformer only, on interleaved 4-mic capture
+    PipelineConfig config;
+    config.high_pass = false;
+    config.noise_suppression = false;
+    AudioPipeline pipeline(16000, 4, config);
+    if (!pipeline.isInitialized()) {
+        std::cout << "[SKIP] AEC3 not initialized" << std::endl;
+        return;
+    }
+    
+    // Talker reaching each mic one sample later than the previous one
+    auto talker = generateSineWave(16000, 440.0f, 2.0f);
+    const size_t frames = talker.size();
+    std::vector<float> interleaved(frames * 4, 0.0f);
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t c = 0; c < 4; ++c) {
+            interleaved[i * 4 + c] = i >= c ? talker[i - c] : 0.0f;
+        }
+    }
+    
+    std::vector<float> output(frames + pipeline.samplesPerFrame());
+    size_t produced = 0;
+    for (size_t pos = 0; pos < frames; pos += 512) {
+        size_t n = std::min<size_t>(512, frames - pos);
+        produced += pipeline.processCapture(interleaved.data() + pos * 4, n, output.data() + produced);
+    }
+    
+    double in_energy = 0.0, out_energy = 0.0;
+    for (size_t i = produced - 16000; i < produced; ++i) {
+        in_energy += talker[i] * talker[i];
+        out_energy += output[i] * output[i];
+    }
+    double level_db = 10.0 * std::log10(out_energy / in_energy);
+    
+    PipelineStats stats = pipeline.getStats();
+    std::cout << "  Output level: " << level_db << " dB vs one mic" << std::endl;
+    std::cout << "  BF time:      " << stats[PipelineStage::Beamform].mean_us() << " us/frame" << std::endl;
+    
+    // One mono frame out per interleaved 10ms frame in, beam formed each time
+    bool mono = produced == (frames / 160) * 160;
+    bool beamformed = stats[PipelineStage::Beamform].frames == stats.frames && stats.frames == produced / 160;
+    bool level = std::abs(level_db) < 3.0;
+    
+    // A single mic has no beamformer stage
+    AudioPipeline single(16000, 1, config);
+    bool no_bf = !single.getStats()[PipelineStage::Beamform].available;
+    
+    if (mono && beamformed && level && no_bf) {
+        std::cout << "[PASS] Interleaved mics cancelled per channel and beamformed to mono" << std::endl;
+    } else {
+        std::cout << "[FAIL] Mic array mono=" << mono << " beamformed=" << beamformed
+                  << " level=" << level << " no_bf=" << no_bf << std::endl;
+    }
+}
+
+/**
+ * Poll a worker-mode pipeline until want samples came out or 2s passed
+ */
+static size_t drainWorker(AudioPipeline& pipeline, float* out, size_t produced, size_t want) {
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (produced < want && std::chrono::steady_clock::now() < give_up) {
+        size_t n = pipeline.processCapture(nullptr, 0, out + produced);
+        if (n == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        produced += n;
+    }
+    return produced;
+}
+
+void test_worker_thread() {
+    std::cout << "\n--- Test: Worker Thread ---" << std::endl;
+    
+    // AGC only, so the synchronous and worker outputs must match exactly
+    PipelineConfig config;
+    config.high_pass = false;
+    config.echo_cancellation = false;
+    config.noise_suppression = false;
+    config.gain_control = true;
+    config.worker_deadline_ms = 1000.0f;
+    
+    AudioPipeline sync(16000, 1, config);
+    config.worker_thread = true;
+    AudioPipeline worker(16000, 1, config);
+    if (!sync.isInitialized() || !worker.isInitialized()) {
+        std::cout << "[SKIP] AEC3 not initialized" << std::endl;
+        return;
+    }
+    
+    // Real-time pacing, 20ms blocks
+    auto input = generateSineWave(16000, 300.0f, 0.5f);
+    for (float& s : input) s *= 0.05f;
+    std::vector<float> expected(input.size() + 160), output(input.size() + 160);
+    size_t expected_count = 0, produced = 0;
+    for (size_t pos = 0; pos < input.size(); pos += 320) {
+        size_t n = std::min<size_t>(320, input.size() - pos);
+        expected_count += sync.processCapture(input.data() + pos, n, expected.data() + expected_count);
+        produced += worker.processCapture(input.data() + pos, n, output.data() + produced);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    produced = drainWorker(worker, output.data(), produced, expected_count);
+    
+    PipelineStats stats = worker.getStats();
+    bool same = produced == expected_count &&
+                std::equal(expected.begin(), expected.begin() + produced, output.begin());
+    bool accounted = stats.worker_thread && stats.frames == produced / 160 &&
+                     stats.frames_late == 0 && stats.frames_dropped == 0;
+    
+    // A deadline nobody can meet: every frame is passed through untouched
+    config.worker_deadline_ms = 0.0f;
+    AudioPipeline late(16000, 1, config);
+    size_t late_count = late.processCapture(input.data(), 1600, output.data());
+    late_count = drainWorker(late, output.data(), late_count, 1600);
+    stats = late.getStats();
+    bool passthrough = late_count == 1600 && stats.frames_late == 10 && stats.frames == 0 &&
+                       std::equal(input.begin(), input.begin() + 1600, output.begin());
+    
+    std::cout << "  Worker frames: " << produced / 160 << ", late " << stats.frames_late
+              << " with a zero deadline" << std::endl;
+    
+    if (same && accounted && passthrough) {
+        std::cout << "[PASS] Worker matches synchronous output and passes late frames through" << std::endl;
+    } else {
+        std::cout << "[FAIL] Worker same=" << same << " accounted=" << accounted
+                  << " passthrough=" << passthrough << std::endl;
+    }
+}
+
 void test_with_audio_engine() {
     std::cout << "\n--- Test: Integration with AudioEngine ---" << std::endl;
     
@@ -121,6 +405,7 @@ void test_with_audio_engine() {
     
     std::cout << "  Frames processed: " << frames_processed << std::endl;
     std::cout << "  Echo detected: " << (pipeline.isEchoDetected() ? "yes" : "no") << std::endl;
+    std::cout << "  Metrics updates: " << pipeline.getMetrics().updates << std::endl;
     
     if (frames_processed > 0) {
         std::cout << "[PASS] AEC3 integration with AudioEngine works" << std::endl;
@@ -134,6 +419,11 @@ int main() {
     
     test_basic_initialization();
     test_echo_cancellation();
+    test_caller_buffer_overload();
+    test_metrics();
+    test_processing_chain();
+    test_mic_array();
+    test_worker_thread();
     test_with_audio_engine();
     
     std::cout << "\nTests complete!" << std::endl;
@@ -56,6 +56,7 @@ int main() {
     std::this_thread::sleep_for(std::chrono::seconds(3));
     
     // Stop
+    AudioStats stats = engine.getStats();
     engine.stop();
     
     // Report
@@ -64,6 +65,12 @@ int main() {
     std::cout << "  Samples captured: " << totalSamples << std::endl;
     std::cout << "  Duration: " << durationSec << " seconds" << std::endl;
     std::cout << "  Expected: ~3.0 seconds" << std::endl;
+    std::cout << "  Input xruns: " << stats.input.xruns()
+              << ", output xruns: " << stats.output.xruns() << std::endl;
+    std::cout << "  Input callback p99: " << stats.input.callback_time.percentile_us(0.99)
+              << "us (max " << stats.input.callback_time.max_us << "us)" << std::endl;
+    std::cout << "  Device latency: in=" << stats.input.device_latency_ms
+              << "ms, out=" << stats.output.device_latency_ms << "ms" << std::endl;
     
     bool success = (durationSec >= 2.5f && durationSec <= 3.5f);
     std::cout << "\n" << (success ? "[PASS]" : "[FAIL]") << " Audio capture test" << std::endl;
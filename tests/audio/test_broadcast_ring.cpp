@@ -0,0 +1,162 @@
+/**
+ * test_broadcast_ring.cpp - Unit test for the SPMC broadcast ring
+ */
+
+#include "rtv/audio/BroadcastRing.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace rtv::audio;
+
+void test_every_consumer_sees_every_sample() {
+    BroadcastRing<float> ring(16);
+    int a = ring.subscribe();
+    int b = ring.subscribe();
+    assert(a >= 0 && b >= 0 && a != b);
+    
+    std::vector<float> data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    ring.publish(data.data(), data.size());
+    assert(ring.available(a) == 5 && ring.available(b) == 5);
+    
+    std::vector<float> out(5);
+    assert(ring.read(a, out.data(), 5) == 5);
+    assert(out == data);
+    assert(ring.available(a) == 0);
+    
+    // b reads independently, in two parts
+    assert(ring.read(b, out.data(), 2) == 2);
+    assert(out[0] == 1.0f && out[1] == 2.0f);
+    assert(ring.read(b, out.data(), 5) == 3);
+    assert(out[0] == 3.0f && out[2] == 5.0f);
+    
+    std::cout << "[PASS] test_every_consumer_sees_every_sample" << std::endl;
+}
+
+void test_late_subscriber_starts_at_head() {
+    BroadcastRing<float> ring(16);
+    std::vector<float> data(10, 1.0f);
+    ring.publish(data.data(), data.size());
+    
+    int id = ring.subscribe();
+    assert(ring.available(id) == 0);
+    
+    std::cout << "[PASS] test_late_subscriber_starts_at_head" << std::endl;
+}
+
+void test_overrun_skips_forward() {
+    BroadcastRing<float> ring(8);
+    int slow = ring.subscribe();
+    int fast = ring.subscribe();
+    
+    std::vector<float> data(12);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i);
+    
+    std::vector<float> out(12);
+    ring.publish(data.data(), 6);
+    assert(ring.read(fast, out.data(), 6) == 6);
+    ring.publish(data.data() + 6, 6);
+    
+    // Fast consumer is unaffected
+    assert(ring.read(fast, out.data(), 12) == 6);
+    assert(out[0] == 6.0f && ring.dropped(fast) == 0);
+    
+    // Slow consumer lost the 4 oldest samples and resumes at the oldest intact one
+    assert(ring.read(slow, out.data(), 12) == 8);
+    assert(out[0] == 4.0f && out[7] == 11.0f);
+    assert(ring.dropped(slow) == 4);
+    
+    std::cout << "[PASS] test_overrun_skips_forward" << std::endl;
+}
+
+void test_peek_release() {
+    BroadcastRing<float> ring(8);
+    int id = ring.subscribe();
+    
+    std::vector<float> data = {1.0f, 2.0f, 3.0f};
+    ring.publish(data.data(), data.size());
+    
+    auto view = ring.peek(id);
+    assert(view.size() == 3 && view.first[2] == 3.0f);
+    assert(ring.release(id, view.size()));
+    
+    // Overwritten while viewed: release reports it
+    ring.publish(data.data(), data.size());
+    view = ring.peek(id);
+    std::vector<float> big(8, 0.0f);
+    ring.publish(big.data(), big.size());
+    assert(!ring.release(id, view.size()));
+    assert(ring.dropped(id) > 0);
+    
+    std::cout << "[PASS] test_peek_release" << std::endl;
+}
+
+void test_slot_reuse() {
+    BroadcastRing<float> ring(8);
+    std::vector<int> ids;
+    for (int i = 0; i < BroadcastRing<float>::kMaxConsumers; ++i) ids.push_back(ring.subscribe());
+    assert(ring.subscribe() == -1);
+    
+    ring.unsubscribe(ids[3]);
+    assert(ring.subscribe() == ids[3]);
+    
+    std::cout << "[PASS] test_slot_reuse" << std::endl;
+}
+
+void test_concurrent_consumers() {
+    BroadcastRing<uint32_t> ring(4096);
+    const uint32_t total = 200000;
+    const int consumers = 3;
+    
+    std::vector<int> ids;
+    for (int i = 0; i < consumers; ++i) ids.push_back(ring.subscribe());
+    
+    // Each consumer checks it sees an increasing sequence; gaps only on overrun
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> received(consumers, 0);
+    for (int i = 0; i < consumers; ++i) {
+        threads.emplace_back([&, i]() {
+            std::vector<uint32_t> out(256);
+            int64_t last = -1;
+            while (last + 1 < total) {
+                size_t n = ring.read(ids[i], out.data(), out.size());
+                for (size_t k = 0; k < n; ++k) {
+                    assert(static_cast<int64_t>(out[k]) > last);
+                    last = out[k];
+                }
+                received[i] += n;
+                if (n == 0) std::this_thread::yield();
+            }
+        });
+    }
+    
+    std::vector<uint32_t> chunk(64);
+    for (uint32_t next = 0; next < total;) {
+        for (uint32_t& v : chunk) v = next++;
+        ring.publish(chunk.data(), chunk.size());
+    }
+    
+    for (auto& t : threads) t.join();
+    for (int i = 0; i < consumers; ++i) {
+        assert(received[i] + ring.dropped(ids[i]) >= total);
+    }
+    
+    std::cout << "[PASS] test_concurrent_consumers (dropped="
+              << ring.dropped(ids[0]) << "/" << ring.dropped(ids[1]) << "/"
+              << ring.dropped(ids[2]) << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "=== BroadcastRing Tests ===" << std::endl;
+    
+    test_every_consumer_sees_every_sample();
+    test_late_subscriber_starts_at_head();
+    test_overrun_skips_forward();
+    test_peek_release();
+    test_slot_reuse();
+    test_concurrent_consumers();
+    
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * test_delay_calibrator.cpp - Chirp delay estimation and per-device persistence
+ */
+
+#include "rtv/audio/DelayCalibrator.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace rtv::audio;
+
+/**
+ * Reference stream: silence, the chirp, silence (as the render tap sees it)
+ */
+static std::vector<float> referenceStream(const std::vector<float>& chirp, size_t lead, size_t total) {
+    std::vector<float> ref(total, 0.0f);
+    std::copy(chirp.begin(), chirp.end(), ref.begin() + lead);
+    return ref;
+}
+
+void test_chirp_shape() {
+    auto chirp = DelayCalibrator::makeChirp(16000, 250, 300.0f, 6000.0f, 0.25f);
+    assert(chirp.size() == 4000);
+
+    float peak = 0.0f;
+    for (float s : chirp) peak = std::max(peak, std::abs(s));
+    assert(peak <= 0.25f + 1e-6f && peak > 0.2f);
+
+    // Faded edges, no click
+    assert(std::abs(chirp.front()) < 1e-3f);
+    assert(std::abs(chirp.back()) < 1e-3f);
+
+    std::cout << "[PASS] Chirp length, level and fades" << std::endl;
+}
+
+void test_finds_delay_in_noise() {
+    const int rate = 16000;
+    auto chirp = DelayCalibrator::makeChirp(rate, 250, 300.0f, 6000.0f, 0.25f);
+    const size_t total = rate;  // 1s window
+    auto ref = referenceStream(chirp, 1600, total);
+
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.02f);
+
+    for (size_t delay : {0u, 37u, 1234u, 3999u}) {
+        // Attenuated, inverted echo with a weak reflection and room noise
+        std::vector<float> cap(total);
+        for (size_t i = 0; i < total; ++i) {
+            float echo = i >= delay ? -0.3f * ref[i - delay] : 0.0f;
+            float reflection = i >= delay + 200 ? 0.1f * ref[i - delay - 200] : 0.0f;
+            cap[i] = echo + reflection + noise(rng);
+        }
+
+        float confidence = 0.0f;
+        int lag = DelayCalibrator::findDelay(ref.data(), ref.size(), cap.data(), cap.size(),
+                                             rate / 2, &confidence);
+        assert(lag == static_cast<int>(delay));
+        assert(confidence > 0.5f && confidence <= 1.0f);
+    }
+
+    std::cout << "[PASS] Delay found through noise, reflection and inverted polarity" << std::endl;
+}
+
+void test_no_echo_is_low_confidence() {
+    const int rate = 16000;
+    auto chirp = DelayCalibrator::makeChirp(rate, 250, 300.0f, 6000.0f, 0.25f);
+    auto ref = referenceStream(chirp, 800, rate);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    std::vector<float> cap(rate);
+    for (float& s : cap) s = noise(rng);
+
+    float confidence = 1.0f;
+    DelayCalibrator::findDelay(ref.data(), ref.size(), cap.data(), cap.size(), rate / 2, &confidence);
+    assert(confidence < DelayCalibratorConfig().min_confidence);
+
+    // Silent reference cannot be located at all
+    std::vector<float> silent(rate, 0.0f);
+    assert(DelayCalibrator::findDelay(silent.data(), silent.size(), cap.data(), cap.size(), 100) == -1);
+
+    std::cout << "[PASS] Missing echo reported with low confidence" << std::endl;
+}
+
+void test_persistence() {
+    const std::string path = "test_delay_calibration.json";
+    std::remove(path.c_str());
+
+    DelayCalibration loaded;
+    assert(!DelayCalibrator::load(path, "mic -> speaker", loaded));
+
+    DelayCalibration a;
+    a.delay_ms = 42;
+    a.measured = true;
+    a.measured_ms = 41.8;
+    a.reported_ms = 60.0;
+    a.confidence = 0.8f;
+    DelayCalibration b;
+    b.delay_ms = 17;
+
+    assert(DelayCalibrator::save(path, "mic -> speaker", a));
+    assert(DelayCalibrator::save(path, "headset -> headset", b));
+
+    // Each device keeps its own entry
+    assert(DelayCalibrator::load(path, "mic -> speaker", loaded));
+    assert(loaded.delay_ms == 42 && loaded.measured);
+    assert(std::abs(loaded.measured_ms - 41.8) < 1e-9);
+    assert(std::abs(loaded.confidence - 0.8f) < 1e-6f);
+    assert(DelayCalibrator::load(path, "headset -> headset", loaded));
+    assert(loaded.delay_ms == 17 && !loaded.measured);
+    assert(!DelayCalibrator::load(path, "other -> other", loaded));
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] Calibration persisted per device" << std::endl;
+}
+
+int main() {
+    std::cout << "=== DelayCalibrator Tests ===" << std::endl;
+
+    test_chirp_shape();
+    test_finds_delay_in_noise();
+    test_no_echo_is_low_confidence();
+    test_persistence();
+
+    std::cout << "\nAll DelayCalibrator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * test_endpointer.cpp - Adaptive end-of-turn detection
+ */
+
+#include "rtv/audio/Endpointer.hpp"
+#include <cassert>
+#include <iostream>
+
+using namespace rtv::audio;
+
+constexpr int FRAME_MS = 10;
+
+/**
+ * Feed ms of speech or silence
+ * @return Silence (ms) at which the turn ended, or -1
+ */
+static int feed(Endpointer& ep, bool speech, int ms) {
+    for (int t = FRAME_MS; t <= ms; t += FRAME_MS) {
+        if (ep.update(speech, FRAME_MS)) return t;
+    }
+    return -1;
+}
+
+void test_default_timeout() {
+    Endpointer ep;
+    assert(feed(ep, false, 2000) == -1);  // Silence alone is never a turn
+
+    // Long turn, no pause history: the default applies
+    assert(feed(ep, true, 1500) == -1);
+    assert(ep.inTurn());
+    assert(feed(ep, false, 2000) == 500);
+    assert(!ep.inTurn());
+
+    EndpointInfo info = ep.lastEndpoint();
+    assert(info.delay_ms == 500 && info.timeout_ms == 500 && info.speech_ms == 1500);
+
+    std::cout << "[PASS] Default timeout before any pauses are known" << std::endl;
+}
+
+void test_default_never_waits_longer() {
+    // Without a transcript hint the old fixed 500ms is an upper bound
+    Endpointer ep;
+    feed(ep, true, 300);
+    assert(feed(ep, false, 2000) == 500);
+
+    // A hesitant speaker: long, uneven pauses push mean + 2 sigma past it
+    feed(ep, true, 1000);
+    for (int pause : {450, 200, 480, 150, 400, 470, 300}) {
+        assert(ep.currentTimeoutMs() <= 500);
+        assert(feed(ep, false, pause) == -1);
+        feed(ep, true, 200);
+    }
+    assert(ep.stats().pauses == 7);
+    assert(ep.currentTimeoutMs() == 500);
+    assert(feed(ep, false, 2000) == 500);
+
+    std::cout << "[PASS] Default config never waits longer than 500ms" << std::endl;
+}
+
+void test_learns_pauses() {
+    Endpointer ep;
+
+    // A fast talker: 120ms pauses between words
+    feed(ep, true, 1000);
+    for (int i = 0; i < 20; ++i) {
+        assert(feed(ep, false, 120) == -1);
+        feed(ep, true, 300);
+    }
+    EndpointerStats stats = ep.stats();
+    assert(stats.pauses == 20);
+    assert(stats.pause_mean_ms > 119.0 && stats.pause_mean_ms < 121.0);
+
+    // Identical pauses: the mean plus the minimum slack
+    assert(ep.currentTimeoutMs() == 220);
+    assert(feed(ep, false, 2000) == 220);
+
+    // A slower talker: 300ms pauses are learned and no longer end the turn
+    Endpointer slow;
+    feed(slow, true, 1000);
+    for (int i = 0; i < 10; ++i) {
+        assert(feed(slow, false, 300) == -1);
+        feed(slow, true, 300);
+    }
+    assert(slow.currentTimeoutMs() == 400);
+
+    // The maximum still caps a very hesitant speaker
+    EndpointerConfig config;
+    config.max_timeout_ms = 400;
+    config.pause_margin = 10.0f;
+    Endpointer capped(config);
+    feed(capped, true, 1000);
+    for (int pause : {200, 350, 150, 300}) {
+        assert(feed(capped, false, pause) == -1);
+        feed(capped, true, 300);
+    }
+    assert(capped.currentTimeoutMs() == 400);
+
+    std::cout << "[PASS] Timeout follows measured pauses within bounds" << std::endl;
+}
+
+void test_transcript_hints() {
+    assert(Endpointer::classify("What time is it?") == TranscriptHint::Complete);
+    assert(Endpointer::classify("Liga a luz.  ") == TranscriptHint::Complete);
+    assert(Endpointer::classify("I want to, ") == TranscriptHint::Incomplete);
+    assert(Endpointer::classify("quero saber se...") == TranscriptHint::Incomplete);
+    assert(Endpointer::classify("toca uma música e") == TranscriptHint::Incomplete);
+    assert(Endpointer::classify("turn on the lights AND") == TranscriptHint::Incomplete);
+    assert(Endpointer::classify("turn on the lights") == TranscriptHint::None);
+    assert(Endpointer::classify("   ") == TranscriptHint::None);
+
+    // A finished question ends the turn early
+    EndpointerConfig config;
+    config.max_timeout_ms = 1000;
+    Endpointer ep(config);
+    feed(ep, true, 1500);
+    ep.setPartialTranscript("Que horas são?");
+    assert(feed(ep, false, 2000) == 250);
+    assert(ep.lastEndpoint().hint == TranscriptHint::Complete);
+
+    // A dangling conjunction holds it open; the hint does not carry over
+    feed(ep, true, 1500);
+    assert(ep.currentTimeoutMs() == 500);
+    ep.setPartialTranscript("acende a luz e");
+    assert(feed(ep, false, 2000) == 1000);
+
+    // No turn in progress: ignored
+    ep.setPartialTranscript("Done.");
+    feed(ep, true, 1500);
+    assert(ep.currentTimeoutMs() == 500);
+
+    std::cout << "[PASS] Partial transcript shortens or extends the wait" << std::endl;
+}
+
+void test_stats_and_reset() {
+    Endpointer ep;
+    feed(ep, true, 1500);
+    feed(ep, false, 2000);   // 500
+    ep.commitTurn(true);
+    feed(ep, true, 1500);
+    ep.setPartialTranscript("ok.");
+    feed(ep, false, 2000);   // 250
+    ep.commitTurn(true);
+
+    // A blip the VAD rejected as too short is not a turn
+    feed(ep, true, 60);
+    ep.setPartialTranscript("hm.");
+    assert(feed(ep, false, 2000) == 250);
+    ep.commitTurn(false);
+
+    EndpointerStats stats = ep.stats();
+    assert(stats.turns == 2 && stats.early_turns == 1);
+    assert(stats.min_delay_ms == 250 && stats.max_delay_ms == 500);
+    assert(stats.mean_delay_ms == 375.0);
+
+    // reset() drops the open turn only
+    feed(ep, true, 500);
+    ep.reset();
+    assert(!ep.inTurn());
+    assert(feed(ep, false, 2000) == -1);
+    assert(ep.stats().turns == 2);
+
+    std::cout << "[PASS] Per-turn delay statistics" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Endpointer Tests ===" << std::endl;
+
+    test_default_timeout();
+    test_default_never_waits_longer();
+    test_learns_pauses();
+    test_transcript_hints();
+    test_stats_and_reset();
+
+    std::cout << "\nAll Endpointer tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * test_playback_mixer.cpp - Unit test for the multi-source playback mixer
+ */
+
+#include "rtv/audio/PlaybackMixer.hpp"
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace rtv::audio;
+
+void test_sequential_clips() {
+    PlaybackMixer mixer;
+    
+    assert(mixer.enqueue(makeClip({0.1f, 0.2f, 0.3f})));
+    assert(mixer.enqueue(makeClip({0.4f, 0.5f})));
+    assert(mixer.queuedSamples() == 5);
+    
+    std::vector<float> out(4);
+    assert(mixer.mix(out.data(), out.size()) == 4);
+    assert(out == std::vector<float>({0.1f, 0.2f, 0.3f, 0.4f}));
+    
+    assert(mixer.mix(out.data(), out.size()) == 1);
+    assert(out == std::vector<float>({0.5f, 0.0f, 0.0f, 0.0f}));
+    assert(!mixer.isActive());
+    
+    std::cout << "[PASS] test_sequential_clips" << std::endl;
+}
+
+void test_shared_clip_no_copy() {
+    PlaybackMixer mixer;
+    AudioClip clip = makeClip(std::vector<float>(100, 0.25f));
+    
+    // Same cached clip queued repeatedly shares one buffer
+    assert(mixer.enqueue(clip));
+    assert(mixer.enqueue(clip));
+    assert(clip.use_count() == 3);
+    
+    std::vector<float> out(200);
+    assert(mixer.mix(out.data(), out.size()) == 200);
+    
+    // Finished clips are released on the next control-side call
+    mixer.enqueue(makeClip({0.0f}));
+    assert(clip.use_count() == 1);
+    
+    std::cout << "[PASS] test_shared_clip_no_copy" << std::endl;
+}
+
+void test_sources_mix_with_gain() {
+    PlaybackMixer mixer;
+    mixer.setGain(1, 0.5f);
+    
+    assert(mixer.enqueue(makeClip({0.2f, 0.2f}), 0));
+    assert(mixer.enqueue(makeClip({0.4f, 0.4f, 0.4f}), 1));
+    
+    std::vector<float> out(3);
+    assert(mixer.mix(out.data(), out.size()) == 3);
+    assert(std::fabs(out[0] - 0.4f) < 1e-6f);
+    assert(std::fabs(out[2] - 0.2f) < 1e-6f);
+    
+    std::cout << "[PASS] test_sources_mix_with_gain" << std::endl;
+}
+
+void test_clear() {
+    PlaybackMixer mixer;
+    assert(mixer.enqueue(makeClip(std::vector<float>(1000, 0.1f))));
+    
+    std::vector<float> out(10);
+    mixer.mix(out.data(), out.size());
+    mixer.clear();
+    
+    assert(mixer.mix(out.data(), out.size()) == 0);
+    assert(mixer.queuedSamples() == 0);
+    
+    std::cout << "[PASS] test_clear" << std::endl;
+}
+
+void test_drain_notification() {
+    PlaybackMixer mixer;
+    assert(mixer.waitForDrain(std::chrono::milliseconds(0)));
+    
+    assert(mixer.enqueue(makeClip(std::vector<float>(480, 0.1f))));
+    assert(!mixer.waitForDrain(std::chrono::milliseconds(1)));
+    
+    // Output thread plays 160-sample blocks every 2ms
+    std::thread output([&]() {
+        std::vector<float> out(160);
+        for (int i = 0; i < 5; ++i) {
+            mixer.mix(out.data(), out.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+    
+    assert(mixer.waitForDrain(std::chrono::seconds(1)));
+    assert(mixer.samplesPlayed() == 480);
+    output.join();
+    
+    std::cout << "[PASS] test_drain_notification" << std::endl;
+}
+
+void test_queue_beyond_depth() {
+    PlaybackMixer mixer;
+    
+    // One clip per sentence, synthesized far ahead of playback
+    const size_t clips = PlaybackMixer::kQueueDepth * 3 + 5;
+    const size_t clipSize = 50;
+    std::vector<float> expected;
+    for (size_t c = 0; c < clips; ++c) {
+        std::vector<float> samples(clipSize, static_cast<float>(c % 100) / 200.0f);
+        expected.insert(expected.end(), samples.begin(), samples.end());
+        assert(mixer.enqueue(makeClip(std::move(samples))));
+    }
+    assert(mixer.queuedSamples() == expected.size());
+    
+    std::atomic<bool> stop{false};
+    std::vector<float> played;
+    std::thread output([&]() {
+        std::vector<float> out(160);
+        while (!stop) {
+            size_t n = mixer.mix(out.data(), out.size());
+            played.insert(played.end(), out.begin(), out.begin() + n);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    
+    assert(mixer.waitForDrain(std::chrono::seconds(5)));
+    stop = true;
+    output.join();
+    
+    assert(played == expected);
+    assert(mixer.samplesPlayed() == expected.size());
+    
+    std::cout << "[PASS] test_queue_beyond_depth" << std::endl;
+}
+
+void test_clear_drops_pending() {
+    PlaybackMixer mixer;
+    for (size_t c = 0; c < PlaybackMixer::kQueueDepth * 2; ++c) {
+        assert(mixer.enqueue(makeClip(std::vector<float>(10, 0.1f))));
+    }
+    
+    mixer.clear();
+    
+    std::vector<float> out(10);
+    assert(mixer.mix(out.data(), out.size()) == 0);
+    assert(mixer.queuedSamples() == 0);
+    assert(mixer.waitForDrain(std::chrono::milliseconds(0)));
+    
+    std::cout << "[PASS] test_clear_drops_pending" << std::endl;
+}
+
+int main() {
+    std::cout << "=== PlaybackMixer Tests ===" << std::endl;
+    
+    test_sequential_clips();
+    test_shared_clip_no_copy();
+    test_sources_mix_with_gain();
+    test_clear();
+    test_drain_notification();
+    test_queue_beyond_depth();
+    test_clear_drops_pending();
+    
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
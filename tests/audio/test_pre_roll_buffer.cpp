@@ -0,0 +1,83 @@
+/**
+ * test_pre_roll_buffer.cpp - Unit test for the capture history ring
+ */
+
+#include "rtv/audio/PreRollBuffer.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace rtv::audio;
+
+void test_partial_fill() {
+    PreRollBuffer preRoll(1000, 10);  // 10 samples
+    assert(preRoll.capacity() == 10 && preRoll.empty());
+    
+    std::vector<float> data = {1.0f, 2.0f, 3.0f};
+    preRoll.write(data.data(), data.size());
+    
+    std::vector<float> out = {0.5f};
+    preRoll.appendTo(out);
+    assert(out == std::vector<float>({0.5f, 1.0f, 2.0f, 3.0f}));
+    
+    std::cout << "[PASS] test_partial_fill" << std::endl;
+}
+
+void test_overwrites_oldest() {
+    PreRollBuffer preRoll(1000, 4);
+    
+    std::vector<float> data = {1.0f, 2.0f, 3.0f};
+    preRoll.write(data.data(), 3);
+    preRoll.write(data.data(), 3);
+    assert(preRoll.size() == 4);
+    
+    std::vector<float> out;
+    preRoll.appendTo(out);
+    assert(out == std::vector<float>({3.0f, 1.0f, 2.0f, 3.0f}));
+    
+    std::cout << "[PASS] test_overwrites_oldest" << std::endl;
+}
+
+void test_oversized_write() {
+    PreRollBuffer preRoll(1000, 3);
+    
+    std::vector<float> data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    preRoll.write(data.data(), data.size());
+    
+    std::vector<float> out;
+    preRoll.appendTo(out);
+    assert(out == std::vector<float>({3.0f, 4.0f, 5.0f}));
+    
+    std::cout << "[PASS] test_oversized_write" << std::endl;
+}
+
+void test_resize_and_disable() {
+    PreRollBuffer preRoll(16000, 300);
+    assert(preRoll.capacity() == 4800);
+    
+    std::vector<float> data(100, 1.0f);
+    preRoll.write(data.data(), data.size());
+    
+    preRoll.setDuration(500);
+    assert(preRoll.capacity() == 8000 && preRoll.empty());
+    
+    preRoll.setDuration(0);
+    preRoll.write(data.data(), data.size());
+    std::vector<float> out;
+    preRoll.appendTo(out);
+    assert(out.empty());
+    
+    std::cout << "[PASS] test_resize_and_disable" << std::endl;
+}
+
+int main() {
+    std::cout << "=== PreRollBuffer Tests ===" << std::endl;
+    
+    test_partial_fill();
+    test_overwrites_oldest();
+    test_oversized_write();
+    test_resize_and_disable();
+    
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
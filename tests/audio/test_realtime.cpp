@@ -0,0 +1,63 @@
+/**
+ * test_realtime.cpp - Unit test for per-page memory lock counting
+ */
+
+#include "rtv/audio/Realtime.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace rtv::audio;
+
+// Locked memory of this process in KB, from /proc/self/status
+long lockedKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmLck:", 0) == 0) return std::stol(line.substr(6));
+    }
+    return -1;
+}
+
+void test_shared_page_stays_locked() {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char* block = static_cast<char*>(std::aligned_alloc(page, page * 2));
+    const long pageKb = static_cast<long>(page / 1024);
+    const long base = lockedKb();
+
+    // Two small buffers on the same page
+    if (!lockMemory(block, 64)) {
+        std::cout << "[SKIP] test_shared_page_stays_locked (mlock refused, RLIMIT_MEMLOCK)" << std::endl;
+        std::free(block);
+        return;
+    }
+    assert(lockMemory(block + 128, 64));
+    assert(lockedKb() == base + pageKb);
+
+    // Releasing one must not unlock the page under the other
+    unlockMemory(block, 64);
+    assert(lockedKb() == base + pageKb);
+
+    // A range spanning both pages, then the last holder of page 0 goes
+    assert(lockMemory(block + page - 8, 16));
+    assert(lockedKb() == base + 2 * pageKb);
+    unlockMemory(block + 128, 64);
+    assert(lockedKb() == base + 2 * pageKb);
+    unlockMemory(block + page - 8, 16);
+    assert(lockedKb() == base);
+
+    std::free(block);
+    std::cout << "[PASS] test_shared_page_stays_locked" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Realtime Tests ===" << std::endl;
+
+    test_shared_page_stays_locked();
+
+    std::cout << "=== All tests passed ===" << std::endl;
+    return 0;
+}
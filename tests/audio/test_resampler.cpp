@@ -0,0 +1,120 @@
+/**
+ * test_resampler.cpp - Unit test for the polyphase resampler
+ */
+
+#include "rtv/audio/Resampler.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace rtv::audio;
+
+static std::vector<float> sine(float freq, int rate, size_t count, float amplitude = 0.5f) {
+    std::vector<float> out(count);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = amplitude * std::sin(2.0f * 3.14159265f * freq * i / rate);
+    }
+    return out;
+}
+
+static float rms(const std::vector<float>& x, size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i) sum += x[i] * x[i];
+    return static_cast<float>(std::sqrt(sum / (end - begin)));
+}
+
+void test_passthrough() {
+    Resampler resampler(16000, 16000);
+    assert(resampler.isPassthrough());
+
+    std::vector<float> in = {0.1f, -0.2f, 0.3f};
+    assert(resampler.process(in) == in);
+
+    std::cout << "[PASS] test_passthrough" << std::endl;
+}
+
+void test_length_and_alignment() {
+    // One-shot conversion keeps duration and timing
+    std::vector<float> in = sine(440.0f, 22050, 22050);
+    std::vector<float> out = Resampler::convert(in, 22050, 24000);
+    assert(out.size() == 24000);
+
+    std::vector<float> ref = sine(440.0f, 24000, 24000);
+    double err = 0.0;
+    for (size_t i = 1000; i < 23000; ++i) err += std::abs(out[i] - ref[i]);
+    assert(err / 22000 < 0.01);
+
+    std::cout << "[PASS] test_length_and_alignment" << std::endl;
+}
+
+void test_passband_gain() {
+    // 1 kHz at 48k -> 16k keeps its level
+    std::vector<float> out = Resampler::convert(sine(1000.0f, 48000, 48000), 48000, 16000);
+    assert(out.size() == 16000);
+
+    float level = rms(out, 1000, 15000);
+    assert(std::abs(level - 0.5f / std::sqrt(2.0f)) < 0.01f);
+
+    std::cout << "[PASS] test_passband_gain (rms=" << level << ")" << std::endl;
+}
+
+void test_aliasing_rejected() {
+    // 12 kHz is above the 8 kHz Nyquist of the target and must not fold back
+    std::vector<float> out = Resampler::convert(sine(12000.0f, 48000, 48000), 48000, 16000);
+    float level = rms(out, 1000, 15000);
+    float db = 20.0f * std::log10(level / (0.5f / std::sqrt(2.0f)) + 1e-12f);
+    assert(db < -60.0f);
+
+    std::cout << "[PASS] test_aliasing_rejected (" << db << " dB)" << std::endl;
+}
+
+void test_streaming_matches_whole() {
+    std::vector<float> in = sine(300.0f, 24000, 9000);
+
+    Resampler whole(24000, 16000);
+    std::vector<float> expected = whole.process(in);
+
+    // Odd block sizes cross the internal buffer boundary and phase wrap
+    Resampler streaming(24000, 16000);
+    std::vector<float> actual;
+    const size_t blocks[] = {1, 7, 160, 333, 1500, 2048};
+    size_t pos = 0;
+    for (size_t b = 0; pos < in.size(); ++b) {
+        size_t n = std::min(blocks[b % 6], in.size() - pos);
+        std::vector<float> out(streaming.maxOutput(n));
+        out.resize(streaming.process(in.data() + pos, n, out.data()));
+        actual.insert(actual.end(), out.begin(), out.end());
+        pos += n;
+    }
+
+    assert(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        assert(std::abs(actual[i] - expected[i]) < 1e-6f);
+    }
+
+    std::cout << "[PASS] test_streaming_matches_whole" << std::endl;
+}
+
+void test_dc_gain() {
+    std::vector<float> out = Resampler::convert(std::vector<float>(4410, 0.25f), 44100, 16000);
+    for (size_t i = 200; i + 200 < out.size(); ++i) {
+        assert(std::abs(out[i] - 0.25f) < 1e-3f);
+    }
+
+    std::cout << "[PASS] test_dc_gain" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Resampler Tests ===" << std::endl;
+
+    test_passthrough();
+    test_length_and_alignment();
+    test_passband_gain();
+    test_aliasing_rejected();
+    test_streaming_matches_whole();
+    test_dc_gain();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
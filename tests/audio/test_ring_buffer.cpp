@@ -67,12 +67,133 @@ void test_concurrent() {
               << ", read=" << total_read << ")" << std::endl;
 }
 
+void test_regions_wrap() {
+    RingBuffer<float> buffer(8);
+    std::vector<float> data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    std::vector<float> out(6);
+    
+    // Move the indices near the end so the next write wraps
+    assert(buffer.push(data.data(), 6) == 6);
+    assert(buffer.pop(out.data(), 6) == 6);
+    
+    auto w = buffer.acquire_write(5);
+    assert(w.first.size() == 2 && w.second.size() == 3);
+    for (size_t i = 0; i < w.first.size(); ++i) w.first[i] = 10.0f + i;
+    for (size_t i = 0; i < w.second.size(); ++i) w.second[i] = 12.0f + i;
+    
+    // Nothing is visible until committed
+    assert(buffer.available() == 0);
+    buffer.commit_write(5);
+    assert(buffer.available() == 5);
+    assert(buffer.space() == 3);
+    
+    auto r = buffer.peek_read();
+    assert(r.size() == 5 && r.first.size() == 2);
+    assert(r.first[0] == 10.0f && r.second[2] == 14.0f);
+    
+    // Peeking does not remove
+    assert(buffer.available() == 5);
+    buffer.consume(3);
+    assert(buffer.pop(out.data(), 8) == 2);
+    assert(out[0] == 13.0f && out[1] == 14.0f);
+    
+    // Full ring: no writable regions
+    assert(buffer.push(data.data(), 6) == 6);
+    assert(buffer.acquire_write(4).size() == 2);
+    
+    std::cout << "[PASS] test_regions_wrap" << std::endl;
+}
+
+void test_in_place_concurrent() {
+    RingBuffer<uint32_t> buffer(100);  // Not a multiple of the block sizes
+    const uint32_t total = 200000;
+    
+    std::thread producer([&]() {
+        uint32_t next = 0;
+        while (next < total) {
+            auto w = buffer.acquire_write(std::min<uint32_t>(37, total - next));
+            for (uint32_t& v : w.first) v = next++;
+            for (uint32_t& v : w.second) v = next++;
+            buffer.commit_write(w.size());
+        }
+    });
+    
+    // Consumer checks every element arrives once and in order
+    uint32_t expected = 0;
+    while (expected < total) {
+        auto r = buffer.peek_read(53);
+        for (uint32_t v : r.first) { assert(v == expected); ++expected; }
+        for (uint32_t v : r.second) { assert(v == expected); ++expected; }
+        buffer.consume(r.size());
+    }
+    producer.join();
+    assert(buffer.empty());
+    
+    std::cout << "[PASS] test_in_place_concurrent" << std::endl;
+}
+
+void test_wait_for_data() {
+    using namespace std::chrono;
+    RingBuffer<float> buffer(64);
+    
+    // Times out when nothing arrives
+    auto start = steady_clock::now();
+    assert(!buffer.wait_for_data(1, start + milliseconds(20)));
+    assert(steady_clock::now() - start >= milliseconds(20));
+    
+    // Wakes when the producer commits enough, not on the first sample
+    std::thread producer([&]() {
+        std::vector<float> one(1, 1.0f);
+        for (int i = 0; i < 16; ++i) {
+            std::this_thread::sleep_for(milliseconds(1));
+            buffer.push(one.data(), 1);
+        }
+    });
+    assert(buffer.wait_for_data(16, steady_clock::now() + seconds(5)));
+    assert(buffer.available() == 16);
+    producer.join();
+    
+    std::cout << "[PASS] test_wait_for_data" << std::endl;
+}
+
+void test_wait_for_space_and_wake() {
+    using namespace std::chrono;
+    RingBuffer<float> buffer(8);
+    std::vector<float> data(8, 1.0f);
+    buffer.push(data.data(), 8);
+    
+    std::thread consumer([&]() {
+        std::this_thread::sleep_for(milliseconds(5));
+        std::vector<float> out(4);
+        buffer.pop(out.data(), 4);
+    });
+    assert(buffer.wait_for_space(4, steady_clock::now() + seconds(5)));
+    consumer.join();
+    
+    // wake() releases a waiter long before its deadline
+    RingBuffer<float> idle(8);
+    std::thread waker([&]() {
+        std::this_thread::sleep_for(milliseconds(5));
+        idle.wake();
+    });
+    auto start = steady_clock::now();
+    assert(!idle.wait_for_data(1, start + seconds(5)));
+    assert(steady_clock::now() - start < seconds(1));
+    waker.join();
+    
+    std::cout << "[PASS] test_wait_for_space_and_wake" << std::endl;
+}
+
 int main() {
     std::cout << "=== RingBuffer Tests ===" << std::endl;
     
     test_basic_push_pop();
     test_overflow();
     test_concurrent();
+    test_regions_wrap();
+    test_in_place_concurrent();
+    test_wait_for_data();
+    test_wait_for_space_and_wake();
     
     std::cout << "\nAll tests passed!" << std::endl;
     return 0;
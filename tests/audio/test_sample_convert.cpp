@@ -0,0 +1,79 @@
+/**
+ * test_sample_convert.cpp - float to int16 conversion (SIMD vs scalar)
+ */
+
+#include "rtv/audio/SampleConvert.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace rtv::audio;
+
+void test_edge_values() {
+    std::vector<float> in = {0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -1.5f, 1e9f, -1e9f,
+                             0.5f, -0.5f, 1.0f / 32767.0f, -1.0f / 32767.0f,
+                             0.99999f, -0.99999f, 3e-5f, -3e-5f, 0.25f};
+    std::vector<int16_t> out(in.size());
+    floatToInt16(in.data(), out.data(), in.size());
+
+    std::vector<int16_t> expected = {0, 0, 32767, -32767, 32767, -32767, 32767, -32767,
+                                     16383, -16383, 1, -1, 32766, -32766, 0, 0, 8191};
+    assert(out == expected);
+
+    std::cout << "[PASS] Clamping, scaling and truncation" << std::endl;
+}
+
+void test_matches_scalar() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+
+    // Every length around the 16-sample vector width, plus a VAD frame
+    for (size_t count = 0; count <= 70; ++count) {
+        std::vector<float> in(count);
+        for (float& s : in) s = dist(rng);
+        std::vector<int16_t> out(count);
+        floatToInt16(in.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            assert(out[i] == floatToInt16(in[i]));
+        }
+    }
+
+    std::vector<float> frame(480);
+    for (float& s : frame) s = dist(rng);
+    std::vector<int16_t> out(frame.size());
+    floatToInt16(frame.data() + 1, out.data(), frame.size() - 1);  // Unaligned
+    for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        assert(out[i] == floatToInt16(frame[i + 1]));
+    }
+
+    std::cout << "[PASS] Bulk conversion matches scalar for every length" << std::endl;
+}
+
+void test_throughput() {
+    std::vector<float> in(16000 * 60);  // One minute at 16kHz
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (float& s : in) s = dist(rng);
+    std::vector<int16_t> out(in.size());
+
+    auto start = std::chrono::steady_clock::now();
+    floatToInt16(in.data(), out.data(), in.size());
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "  One minute of 16kHz audio in " << us << " us" << std::endl;
+
+    std::cout << "[PASS] Throughput" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SampleConvert Tests ===" << std::endl;
+
+    test_edge_values();
+    test_matches_scalar();
+    test_throughput();
+
+    std::cout << "\nAll SampleConvert tests passed!" << std::endl;
+    return 0;
+}
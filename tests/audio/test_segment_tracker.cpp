@@ -0,0 +1,104 @@
+/**
+ * test_segment_tracker.cpp - Unit test for speech segment stream positions
+ */
+
+#include "rtv/audio/SegmentTracker.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace rtv::audio;
+
+constexpr int RATE = 16000;
+constexpr size_t FRAME = 320;     // 20ms
+constexpr size_t PRE_ROLL = 4800; // 300ms
+
+// Replays what VADProcessor reports for one segment: Start while the first
+// speech frame is processed, End on the endpoint frame with the whole
+// segment (pre-roll up to `pre_roll` samples, then onset..endpoint)
+struct Stream {
+    SegmentTracker tracker{FRAME, RATE};
+    std::vector<float> audio = std::vector<float>(RATE * 10, 0.0f);
+
+    bool segment(size_t onset, size_t pre_roll, size_t speech_end, int delay_ms, bool accepted = true) {
+        SpeechEvent start;
+        start.type = SpeechEventType::Start;
+        bool ended = tracker.onEvent(start, onset + FRAME);
+        assert(!ended);
+
+        const size_t endpoint = speech_end + static_cast<size_t>(delay_ms) * RATE / 1000;
+        const size_t length = pre_roll + (endpoint - onset);
+
+        // Delivered as chunks plus a remainder, like the real stream
+        SpeechEvent end;
+        end.type = SpeechEventType::End;
+        end.offset = length - 1000;
+        end.audio.first = std::span<const float>(audio.data(), 1000);
+        end.accepted = accepted;
+        end.endpoint_delay_ms = delay_ms;
+        return tracker.onEvent(end, endpoint);
+    }
+};
+
+void test_full_pre_roll() {
+    Stream s;
+    assert(s.segment(32000, PRE_ROLL, 48000, 500));
+
+    const SegmentBounds& b = s.tracker.last();
+    assert(b.speech_start == 32000);
+    assert(b.start == 32000 - PRE_ROLL);
+    assert(b.speech_end == 48000);
+    assert(b.end == 56000);
+
+    std::cout << "[PASS] test_full_pre_roll" << std::endl;
+}
+
+void test_back_to_back_segments() {
+    Stream s;
+    assert(s.segment(80000, PRE_ROLL, 92000, 500));
+    assert(s.tracker.last().end == 100000);
+
+    // Speech resumes 2000 samples after the previous endpoint: the pre-roll
+    // is just that gap, and the onset must not move back to the endpoint
+    assert(s.segment(102000, 2000, 110000, 400));
+    const SegmentBounds& b = s.tracker.last();
+    assert(b.start == 100000);
+    assert(b.speech_start == 102000);
+    assert(b.speech_end == 110000);
+
+    // Speech right at the endpoint: no pre-roll at all
+    assert(s.segment(116400, 0, 120000, 300));
+    assert(s.tracker.last().start == 116400 && s.tracker.last().speech_start == 116400);
+
+    std::cout << "[PASS] test_back_to_back_segments" << std::endl;
+}
+
+void test_speech_at_file_start() {
+    Stream s;
+    // 100ms into the file: only 1600 samples of pre-roll exist
+    assert(s.segment(1600, 1600, 9600, 500));
+    const SegmentBounds& b = s.tracker.last();
+    assert(b.start == 0);
+    assert(b.speech_start == 1600);
+
+    std::cout << "[PASS] test_speech_at_file_start" << std::endl;
+}
+
+void test_rejected_segment() {
+    Stream s;
+    assert(!s.segment(16000, PRE_ROLL, 17600, 500, false));
+
+    std::cout << "[PASS] test_rejected_segment" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SegmentTracker Tests ===" << std::endl;
+
+    test_full_pre_roll();
+    test_back_to_back_segments();
+    test_speech_at_file_start();
+    test_rejected_segment();
+
+    std::cout << "=== All tests passed ===" << std::endl;
+    return 0;
+}
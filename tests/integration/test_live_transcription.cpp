@@ -13,6 +13,7 @@
 
 #include "rtv/audio/AudioEngine.hpp"
 #include "rtv/audio/AudioPipeline.hpp"
+#include "rtv/audio/BroadcastRing.hpp"
 #include "rtv/audio/VADProcessor.hpp"
 #include "rtv/stt/STTEngine.hpp"
 
@@ -45,9 +46,12 @@ int main() {
     }
     std::cout << "[Init] Model loaded: " << stt.getModelInfo() << std::endl;
     
-    // Initialize Audio Pipeline (AEC3)
+    // Initialize Audio Pipeline (AEC3). Capture here is not threaded, so the
+    // chain gets its own worker instead of running in the PortAudio callback
     std::cout << "[Init] Initializing AEC3..." << std::endl;
-    rtv::audio::AudioPipeline pipeline(16000);
+    rtv::audio::PipelineConfig pipeline_config;
+    pipeline_config.worker_thread = true;
+    rtv::audio::AudioPipeline pipeline(16000, 1, pipeline_config);
     
     // Initialize VAD Processor
     std::cout << "[Init] Initializing VAD..." << std::endl;
@@ -55,12 +59,23 @@ int main() {
     vad.setSilenceTimeout(700);      // 700ms silence = end of speech
     vad.setMinSpeechDuration(300);   // Minimum 300ms to consider valid speech
     
-    // Set up speech callback - transcribe when speech segment ends
-    vad.setSpeechCallback([&stt](const std::vector<float>& samples, int duration_ms) {
-        std::cout << "\n[VAD] Speech detected (" << duration_ms << "ms), transcribing..." << std::endl;
+    // Stream each segment in 250ms chunks while the user is still talking,
+    // so the utterance is already assembled when the endpoint fires
+    std::vector<float> utterance;
+    utterance.reserve(16000 * 30);
+    vad.setSpeechEventCallback([&stt, &utterance](const rtv::audio::SpeechEvent& event) {
+        if (event.type == rtv::audio::SpeechEventType::Start) {
+            utterance.clear();
+            return;
+        }
+        utterance.insert(utterance.end(), event.audio.first.begin(), event.audio.first.end());
+        utterance.insert(utterance.end(), event.audio.second.begin(), event.audio.second.end());
+        if (event.type != rtv::audio::SpeechEventType::End || !event.accepted) return;
+        
+        std::cout << "\n[VAD] Speech detected (" << event.duration_ms << "ms), transcribing..." << std::endl;
         
         auto start = std::chrono::high_resolution_clock::now();
-        std::string text = stt.transcribe(samples);
+        std::string text = stt.transcribe(utterance);
         auto end = std::chrono::high_resolution_clock::now();
         
         auto inference_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -72,7 +87,7 @@ int main() {
             std::cout << "[STT] (no speech detected)" << std::endl;
         }
         std::cout << std::endl;
-    });
+    }, 250);
     
     // Initialize Audio Engine
     std::cout << "[Init] Initializing AudioEngine..." << std::endl;
@@ -81,13 +96,23 @@ int main() {
     audio_config.frames_per_buffer = 320;  // 20ms frames
     rtv::audio::AudioEngine audio(audio_config);
     
-    // Set up audio callback - process through AEC3 then VAD
-    audio.setInputCallback([&pipeline, &vad](const float* samples, size_t count) {
-        // Process through AEC3 (echo cancellation)
-        std::vector<float> processed = pipeline.processCapture(samples, count);
-        
-        // Process through VAD (voice activity detection)
-        vad.process(processed.data(), processed.size());
+    // AEC3 runs inside AudioEngine, fed by the speaker render tap
+    audio.setEchoCanceller(&pipeline);
+    
+    // VAD (and the STT it triggers) reads echo-cancelled audio on its own
+    // thread, so a slow transcription never stalls capture
+    auto& capture = audio.captureBroadcast();
+    int vad_reader = capture.subscribe();
+    std::thread vad_thread([&]() {
+        std::vector<float> block(audio_config.frames_per_buffer);
+        while (g_running) {
+            size_t n = capture.read(vad_reader, block.data(), block.size());
+            if (n == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                continue;
+            }
+            vad.process(block.data(), n);
+        }
     });
     
     // Start audio capture
@@ -115,6 +140,17 @@ int main() {
     std::cout << "[Stopping] Shutting down..." << std::endl;
     
     audio.stop();
+    vad_thread.join();
+    
+    rtv::audio::PipelineStats aec_stats = pipeline.getStats();
+    if (aec_stats.frames_late > 0 || aec_stats.frames_dropped > 0) {
+        std::cout << "[Stopping] AEC worker: " << aec_stats.frames_late << " frames late, "
+                  << aec_stats.frames_dropped << " dropped" << std::endl;
+    }
+    
+    if (uint64_t dropped = capture.dropped(vad_reader)) {
+        std::cout << "[Stopping] VAD fell behind and skipped " << dropped << " samples" << std::endl;
+    }
     
     std::cout << "[Done] Goodbye!" << std::endl;
     return 0;